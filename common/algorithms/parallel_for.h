@@ -48,6 +48,15 @@ namespace embree
     concurrency::parallel_for(Index(0),N,Index(1),[&](Index i) { 
         func(i);
       });
+
+#elif defined(TASKING_EXTERNAL)
+    if (N) {
+      TaskScheduler::spawn(Index(0),N,Index(1),[&] (const range<Index>& r) {
+          assert(r.size() == 1);
+          func(r.begin());
+        });
+    }
+
 #else
 #  error "no tasking system enabled"
 #endif
@@ -75,6 +84,9 @@ namespace embree
         func(range<Index>(i,i+1)); 
       });
 
+#elif defined(TASKING_EXTERNAL)
+    TaskScheduler::spawn(first,last,minStepSize,func);
+
 #else
 #  error "no tasking system enabled"
 #endif
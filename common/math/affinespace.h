@@ -147,6 +147,7 @@ namespace embree
   typedef AffineSpaceT<LinearSpace2f> AffineSpace2f;
   typedef AffineSpaceT<LinearSpace3f> AffineSpace3f;
   typedef AffineSpaceT<LinearSpace3fa> AffineSpace3fa;
+  typedef AffineSpaceT<LinearSpace3d> AffineSpace3d;
   typedef AffineSpaceT<Quaternion3f > OrthonormalSpace3f;
 
   ////////////////////////////////////////////////////////////////////////////////
@@ -217,6 +217,11 @@ namespace embree
   __forceinline float nmsub ( const float a, const float b, const float c) { return -a*b-c; }
 #endif
 
+  __forceinline double madd  ( const double a, const double b, const double c) { return a*b+c; }
+  __forceinline double msub  ( const double a, const double b, const double c) { return a*b-c; }
+  __forceinline double nmadd ( const double a, const double b, const double c) { return -a*b+c;}
+  __forceinline double nmsub ( const double a, const double b, const double c) { return -a*b-c; }
+
   /*! random functions */
   template<typename T> T random() { return T(0); }
 #if defined(_WIN32)
@@ -240,6 +240,7 @@ namespace embree
   typedef Vec3<bool > Vec3b;
   typedef Vec3<int  > Vec3i;
   typedef Vec3<float> Vec3f;
+  typedef Vec3<double> Vec3d;
 }
 
 #include "vec3ba.h"
@@ -270,6 +271,7 @@ namespace embree
   }
 
   template<> __forceinline Vec3<float>::Vec3( const Vec3fa& a ) { x = a.x; y = a.y; z = a.z; }
+  template<> __forceinline Vec3<double>::Vec3( const Vec3fa& a ) { x = a.x; y = a.y; z = a.z; }
 
 #if defined (__SSE__)
   template<> __forceinline Vec3<vfloat4>::Vec3( const Vec3fa& a ) {
@@ -64,6 +64,22 @@ namespace embree
     if (!VirtualFree(ptr,0,MEM_RELEASE))
       /*throw std::bad_alloc()*/ return;  // we on purpose do not throw an exception when an error occurs, to avoid throwing an exception during error handling
   }
+
+  void* os_map_file(const char* fileName, size_t bytes)
+  {
+    HANDLE file = CreateFileA(fileName,GENERIC_READ|GENERIC_WRITE,0,nullptr,OPEN_ALWAYS,FILE_ATTRIBUTE_NORMAL,nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+    HANDLE mapping = CreateFileMappingA(file,nullptr,PAGE_READWRITE,DWORD(uint64_t(bytes) >> 32),DWORD(bytes),nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return nullptr;
+    void* ptr = MapViewOfFile(mapping,FILE_MAP_ALL_ACCESS,0,0,bytes);
+    CloseHandle(mapping); // the view keeps the mapping alive
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes) {
+    if (ptr) UnmapViewOfFile(ptr);
+  }
 }
 #endif
 
@@ -74,6 +90,9 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -199,6 +218,26 @@ namespace embree
     if (munmap(ptr,bytes) == -1)
       /*throw std::bad_alloc()*/ return;  // we on purpose do not throw an exception when an error occurs, to avoid throwing an exception during error handling
   }
+  void* os_map_file(const char* fileName, size_t bytes)
+  {
+    int fd = open(fileName,O_RDWR|O_CREAT,0644);
+    if (fd == -1) return nullptr;
+
+    /* grow the file such that all mapped pages are backed by the file */
+    struct stat st;
+    if (fstat(fd,&st) == -1 || (size_t(st.st_size) < bytes && ftruncate(fd,bytes) == -1)) {
+      close(fd);
+      return nullptr;
+    }
+    void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // the mapping keeps the file open
+    if (ptr == MAP_FAILED) return nullptr;
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes) {
+    if (ptr) munmap(ptr,bytes);
+  }
 }
 
 #endif
@@ -82,6 +82,10 @@ namespace embree
   size_t os_shrink (void* ptr, size_t bytesNew, size_t bytesOld);
   void  os_free   (void* ptr, size_t bytes);
 
+  /*! maps the first bytes of some file into memory, the file gets created and grown as required, returns nullptr on failure */
+  void* os_map_file  (const char* fileName, size_t bytes);
+  void  os_unmap_file(void* ptr, size_t bytes);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
@@ -0,0 +1,43 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "taskschedulerexternal.h"
+#include "../sys/sysinfo.h"
+#include "../math/math.h"
+
+namespace embree
+{
+  TaskScheduler::RunJobsFunc TaskScheduler::g_runJobs = nullptr;
+  TaskScheduler::ThreadIndexFunc TaskScheduler::g_threadIndex = nullptr;
+  size_t TaskScheduler::g_threadCount = 1;
+  void* TaskScheduler::g_userPtr = nullptr;
+
+  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads) {
+    /* threads are owned by the external job system */
+  }
+
+  void TaskScheduler::destroy() {
+    setJobSystem(nullptr,nullptr,1,nullptr);
+  }
+
+  void TaskScheduler::setJobSystem(RunJobsFunc runJobs, ThreadIndexFunc threadIndex, size_t threadCount, void* userPtr)
+  {
+    g_runJobs = runJobs;
+    g_threadIndex = runJobs ? threadIndex : nullptr;
+    g_threadCount = max(size_t(1),min(threadCount,size_t(MAX_THREADS)));
+    g_userPtr = userPtr;
+  }
+}
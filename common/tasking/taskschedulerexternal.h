@@ -0,0 +1,123 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../sys/platform.h"
+#include "../sys/alloc.h"
+#include "../sys/barrier.h"
+#include "../sys/thread.h"
+#include "../sys/mutex.h"
+#include "../sys/condition.h"
+#include "../sys/ref.h"
+#include "../math/range.h"
+
+#include <exception>
+
+namespace embree
+{  
+  /*! Forwards all parallel work to an external job system provided by
+   *  the application. Without a job system all work runs on the
+   *  calling thread. */
+  struct TaskScheduler
+  {
+    /*! executes the jobIndex'th job of jobCount many jobs */
+    typedef void (*JobFunc)(void* jobPtr, size_t jobIndex, size_t jobCount);
+
+    /*! executes jobCount many jobs, potentially in parallel, and returns when all jobs have finished */
+    typedef void (*RunJobsFunc)(void* userPtr, JobFunc job, void* jobPtr, size_t jobCount);
+
+    /*! returns the index of the calling worker thread */
+    typedef size_t (*ThreadIndexFunc)(void* userPtr);
+
+    /*! initializes the task scheduler */
+    static void create(size_t numThreads, bool set_affinity, bool start_threads);
+
+    /*! destroys the task scheduler again */
+    static void destroy();
+
+    /*! sets the external job system, a null runJobs function disables the job system again */
+    __dllexport static void setJobSystem(RunJobsFunc runJobs, ThreadIndexFunc threadIndex, size_t threadCount, void* userPtr);
+
+    /* returns the index of the current thread */
+    static __forceinline size_t threadIndex() {
+      return g_threadIndex ? g_threadIndex(g_userPtr) : 0;
+    }
+
+    /* returns the total number of threads */
+    static __forceinline size_t threadCount() {
+      return g_runJobs ? g_threadCount : 1;
+    }
+
+    /* executes closure(i) for all i in [0,N) through the job system and waits for all of them */
+    template<typename Closure>
+      static void run(const size_t N, const Closure& closure)
+    {
+      if (N == 1 || g_runJobs == nullptr) {
+        for (size_t i=0; i<N; i++) closure(i);
+        return;
+      }
+
+      /* exceptions must not propagate through the job system, we rethrow them after all jobs finished */
+      struct Jobs
+      {
+        Jobs (const Closure& closure) : closure(closure), failed(false) {}
+
+        static void execute(void* jobPtr, size_t jobIndex, size_t jobCount)
+        {
+          Jobs* jobs = (Jobs*) jobPtr;
+          try {
+            jobs->closure(jobIndex);
+          } catch (...) {
+            Lock<SpinLock> lock(jobs->mutex);
+            if (!jobs->failed) jobs->exception = std::current_exception();
+            jobs->failed = true;
+          }
+        }
+
+        const Closure& closure;
+        SpinLock mutex;
+        bool failed;
+        std::exception_ptr exception;
+      };
+
+      Jobs jobs(closure);
+      g_runJobs(g_userPtr,&Jobs::execute,&jobs,N);
+      if (jobs.failed) std::rethrow_exception(jobs.exception);
+    }
+
+    /* recursively splits the range in halves until it contains at most blockSize items */
+    template<typename Index, typename Closure>
+      static void spawn(const Index begin, const Index end, const Index blockSize, const Closure& closure) 
+    {
+      if (end-begin <= blockSize) {
+        closure(range<Index>(begin,end));
+        return;
+      }
+      const Index center = (begin+end)/2;
+      run(2,[&] (size_t i) {
+          if (i == 0) spawn(begin,center,blockSize,closure);
+          else        spawn(center,end  ,blockSize,closure);
+        });
+    }
+
+  private:
+    __dllexport static RunJobsFunc g_runJobs;
+    __dllexport static ThreadIndexFunc g_threadIndex;
+    __dllexport static size_t g_threadCount;
+    __dllexport static void* g_userPtr;
+  };
+};
@@ -134,8 +134,8 @@ namespace embree
     pool->thread_loop(threadIndex);
   }
 
-  TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+  TaskScheduler::ThreadPool::ThreadPool(bool set_affinity, size_t affinity_offset)
+    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), affinity_offset(affinity_offset), running(false) {}
 
   __dllexport void TaskScheduler::ThreadPool::startThreads()
   {
@@ -165,7 +165,8 @@ namespace embree
     {
       if (t == 0) continue;
       auto pair = new std::pair<TaskScheduler::ThreadPool*,size_t>(this,t);
-      threads.push_back(createThread((thread_func)threadPoolFunction,pair,4*1024*1024,set_affinity ? t : -1));
+      const ssize_t affinity = set_affinity ? ssize_t((affinity_offset+t) % getNumberOfLogicalThreads()) : -1;
+      threads.push_back(createThread((thread_func)threadPoolFunction,pair,4*1024*1024,affinity));
     }
 
     /* stop some threads if we reduce the number of threads */
@@ -225,10 +226,11 @@ namespace embree
     }
   }
   
-  TaskScheduler::TaskScheduler()
-    : threadCounter(0), anyTasksRunning(0), hasRootTask(false) 
+  TaskScheduler::TaskScheduler(ThreadPool* pool)
+    : pool(pool), threadCounter(0), anyTasksRunning(0), hasRootTask(false) 
   {
-    threadLocal.resize(2*getNumberOfLogicalThreads()); // FIXME: this has to be 2x as in the join mode the worker threads also join
+    const size_t poolSize = pool ? pool->size() : 0;
+    threadLocal.resize(2*max(size_t(getNumberOfLogicalThreads()),poolSize)); // FIXME: this has to be 2x as in the join mode the worker threads also join
     for (size_t i=0; i<threadLocal.size(); i++)
       threadLocal[i].store(nullptr);
   }
@@ -245,8 +247,11 @@ namespace embree
     else        return 0;
   }
 
-  __dllexport size_t TaskScheduler::threadCount() {
-    return threadPool->size();
+  __dllexport size_t TaskScheduler::threadCount() 
+  {
+    Thread* thread = TaskScheduler::thread();
+    if (thread) return thread->scheduler->getThreadPool()->size();
+    else        return threadPool->size();
   }
 
   __dllexport TaskScheduler* TaskScheduler::instance() 
@@ -382,15 +387,19 @@ namespace embree
     return false;
   }
 
+  TaskScheduler::ThreadPool* TaskScheduler::getThreadPool() const {
+    return pool ? pool : threadPool;
+  }
+
   __dllexport void TaskScheduler::startThreads() {
-    threadPool->startThreads();
+    getThreadPool()->startThreads();
   }
 
   __dllexport void TaskScheduler::addScheduler(const Ref<TaskScheduler>& scheduler) {
-    threadPool->add(scheduler);
+    getThreadPool()->add(scheduler);
   }
 
   __dllexport void TaskScheduler::removeScheduler(const Ref<TaskScheduler>& scheduler) {
-    threadPool->remove(scheduler);
+    getThreadPool()->remove(scheduler);
   }
 }
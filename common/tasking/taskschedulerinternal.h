@@ -196,7 +196,7 @@ namespace embree
     /*! pool of worker threads */
     struct ThreadPool
     {
-      ThreadPool (bool set_affinity);
+      ThreadPool (bool set_affinity, size_t affinity_offset = 0);
       ~ThreadPool ();
 
       /*! starts the threads */
@@ -221,6 +221,7 @@ namespace embree
       std::atomic<size_t> numThreads;
       std::atomic<size_t> numThreadsRunning;
       bool set_affinity;
+      size_t affinity_offset;
       std::atomic<bool> running;
       std::vector<thread_t> threads;
 
@@ -230,7 +231,7 @@ namespace embree
       std::list<Ref<TaskScheduler> > schedulers;
     };
 
-    TaskScheduler ();
+    TaskScheduler (ThreadPool* pool = nullptr);
     ~TaskScheduler ();
 
     /*! initializes the task scheduler */
@@ -352,16 +353,20 @@ namespace embree
     /*! returns the taskscheduler object to be used by the master thread */
     __dllexport static TaskScheduler* instance();
 
+    /*! returns the thread pool this task scheduler uses for scheduling */
+    ThreadPool* getThreadPool() const;
+
     /*! starts the threads */
-    __dllexport static void startThreads();
+    __dllexport void startThreads();
 
     /*! adds a task scheduler object for scheduling */
-    __dllexport static void addScheduler(const Ref<TaskScheduler>& scheduler);
+    __dllexport void addScheduler(const Ref<TaskScheduler>& scheduler);
 
     /*! remove the task scheduler object again */
-    __dllexport static void removeScheduler(const Ref<TaskScheduler>& scheduler);
+    __dllexport void removeScheduler(const Ref<TaskScheduler>& scheduler);
 
   private:
+    ThreadPool* pool;                  //!< private thread pool, uses the global thread pool if nullptr
     std::vector<atomic<Thread*>> threadLocal;
     std::atomic<size_t> threadCounter;
     std::atomic<size_t> anyTasksRunning;
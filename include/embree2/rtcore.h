@@ -155,7 +155,7 @@ enum RTCParameter {
   RTC_CONFIG_INTERSECTION_FILTER = 8,         //!< checks if intersection filters are enabled (read only)
   RTC_CONFIG_INTERSECTION_FILTER_RESTORE = 9, //!< checks if intersection filters restores previous hit (read only)
   RTC_CONFIG_IGNORE_INVALID_RAYS = 11,        //!< checks if invalid rays are ignored (read only)
-  RTC_CONFIG_TASKING_SYSTEM = 12,             //!< return used tasking system (0 = INTERNAL, 1 = TBB) (read only)
+  RTC_CONFIG_TASKING_SYSTEM = 12,             //!< return used tasking system (0 = INTERNAL, 1 = TBB, 2 = EXTERNAL) (read only)
 
   RTC_CONFIG_VERSION_MAJOR = 13,             //!< returns Embree major version (read only)
   RTC_CONFIG_VERSION_MINOR = 14,             //!< returns Embree minor version (read only)
@@ -239,6 +239,23 @@ RTCORE_API RTCORE_DEPRECATED void rtcSetMemoryMonitorFunction(RTCMemoryMonitorFu
  *  called before or after the library allocates or frees memory. */
 RTCORE_API void rtcDeviceSetMemoryMonitorFunction(RTCDevice device, RTCMemoryMonitorFunc func);
 
+/*! \brief Type of a job function of an external job system. */
+typedef void (*RTCJobFunc)(void* jobPtr, size_t jobIndex, size_t jobCount);
+
+/*! \brief Type of the function that has to execute the jobs with
+ *  index 0 to jobCount-1, potentially in parallel, and that has to
+ *  return after all these jobs finished. */
+typedef void (*RTCRunJobsFunc)(void* userPtr, RTCJobFunc job, void* jobPtr, size_t jobCount);
+
+/*! \brief Type of the function that returns the index of the worker
+ *  thread that calls it, in the range 0 to threadCount-1. */
+typedef size_t (*RTCThreadIndexFunc)(void* userPtr);
+
+/*! \brief Forwards all parallel work of hierarchy builds to an external
+ *  job system of the application. Requires Embree to be compiled with
+ *  the EXTERNAL tasking system. */
+RTCORE_API void rtcDeviceSetJobSystem(RTCDevice device, RTCRunJobsFunc runJobs, RTCThreadIndexFunc threadIndex, size_t threadCount, void* userPtr);
+
 /*! \brief Implementation specific (do not call).
 
   This function is implementation specific and only for debugging
@@ -129,6 +129,46 @@ typedef void (*RTCDisplacementFunc2)(void* ptr,           /*!< pointer to user d
                                      float* pz,           /*!< z coordinates of points to displace (source and target) */
                                      size_t N             /*!< number of points to displace */ );
 
+/*! Grid of a single patch inside a displacement batch. */
+struct RTCDisplacementGrid
+{
+  unsigned primID;     /*!< ID of primitive of geometry to displace */
+  unsigned time;       /*!< time step to calculate displacement for */
+  unsigned begin;      /*!< index of first point of the grid, always a multiple of 16 */
+  unsigned N;          /*!< number of points of the grid */
+};
+
+/*! Points of the grids of multiple patches of some geometry to
+ *  displace. All arrays are 64 bytes aligned and store numPoints
+ *  elements. Points between two grids are padding, they contain a copy
+ *  of the last point of the previous grid and their displaced position
+ *  is ignored. */
+struct RTCDisplacementBatch
+{
+  unsigned geomID;                          /*!< ID of geometry to displace */
+  unsigned numGrids;                        /*!< number of grids in the batch */
+  const struct RTCDisplacementGrid* grids;  /*!< grids of the batch */
+  size_t numPoints;                         /*!< number of points of all grids including padding */
+  const float* u;                           /*!< u coordinates (source) */
+  const float* v;                           /*!< v coordinates (source) */
+  const float* nx;                          /*!< x coordinates of normalized normal at point to displace (source) */
+  const float* ny;                          /*!< y coordinates of normalized normal at point to displace (source) */
+  const float* nz;                          /*!< z coordinates of normalized normal at point to displace (source) */
+  const float* dPdux;                       /*!< x coordinates of partial derivative of position wrt. u (source) */
+  const float* dPduy;                       /*!< y coordinates of partial derivative of position wrt. u (source) */
+  const float* dPduz;                       /*!< z coordinates of partial derivative of position wrt. u (source) */
+  const float* dPdvx;                       /*!< x coordinates of partial derivative of position wrt. v (source) */
+  const float* dPdvy;                       /*!< y coordinates of partial derivative of position wrt. v (source) */
+  const float* dPdvz;                       /*!< z coordinates of partial derivative of position wrt. v (source) */
+  float* px;                                /*!< x coordinates of points to displace (source and target) */
+  float* py;                                /*!< y coordinates of points to displace (source and target) */
+  float* pz;                                /*!< z coordinates of points to displace (source and target) */
+};
+
+/*! Displacement mapping function for the grids of multiple patches. */
+typedef void (*RTCDisplacementBatchFunc)(void* ptr,                                /*!< pointer to user data of geometry */
+                                         const struct RTCDisplacementBatch* batch  /*!< points to displace */ );
+
 /*! \brief Creates a new scene instance. 
 
   A scene instance contains a reference to a scene to instantiate and
@@ -171,6 +211,20 @@ RTCORE_API void rtcSetTransform2 (RTCScene scene,                         //!< s
                                   size_t timeStep = 0                     //!< timestep to set the matrix for 
   );
 
+/*! \brief Sets double precision transformation of the instance for
+  specified timestep. Transformations of instance bounds and rays into
+  the local space of the instance are then performed in double
+  precision, which avoids precision issues when instancing objects far
+  away from the origin. The instanced scene itself stays single
+  precision, thus its geometry should be specified in local
+  coordinates close to the origin. */
+RTCORE_API void rtcSetTransformd (RTCScene scene,                         //!< scene handle
+                                  unsigned int geomID,                    //!< ID of geometry 
+                                  RTCMatrixType layout,                   //!< layout of transformation matrix
+                                  const double* xfm,                      //!< pointer to transformation matrix
+                                  size_t timeStep = 0                     //!< timestep to set the matrix for 
+  );
+
 /*! \brief Creates a new triangle mesh. The number of triangles
   (numTriangles), number of vertices (numVertices), and number of time
   steps (1 for normal meshes, and 2 for linear motion blur), have to
@@ -330,6 +384,33 @@ RTCORE_API unsigned rtcNewCurveGeometry (RTCScene scene,                    //!<
  *  optionally to set a different tessellation rate per edge.*/
 RTCORE_API void rtcSetTessellationRate (RTCScene scene, unsigned geomID, float tessellationRate);
 
+/*! \brief Camera used to calculate the tessellation levels of
+ *  subdivision meshes. The transformation maps homogeneous world
+ *  space points to clip space, where points inside the view frustum
+ *  fulfill -w <= x <= w, -w <= y <= w, and w > 0. */
+struct RTCTessellationCamera
+{
+  float xfm[16];  //!< world to clip space transformation, stored in column major order
+  float width;    //!< width of the viewport in pixels
+  float height;   //!< height of the viewport in pixels
+};
+
+/*! Sets cameras from which the tessellation levels of a subdivision
+ *  mesh get calculated during build. Each edge is tessellated such
+ *  that its segments project to about edgeLength pixels in the camera
+ *  where the edge appears largest. Edges outside of all view frusta
+ *  get the minimal tessellation level. The RTC_LEVEL_BUFFER and the
+ *  tessellation rate are ignored while cameras are set. Passing zero
+ *  cameras disables this mode. Changing the cameras of a dynamic
+ *  scene retessellates the mesh at the next commit. */
+RTCORE_API void rtcSetTessellationCameras (RTCScene scene, unsigned geomID, const RTCTessellationCamera* cameras, size_t numCameras, float edgeLength);
+
+/*! Sets the distance from the ray origin beyond which the curves of
+ *  a hair geometry are intersected as flat, ray facing ribbons
+ *  instead of round tubes. Defaults to infinity, which disables the
+ *  ribbon mode. A distance of zero renders all curves as ribbons. */
+RTCORE_API void rtcSetCurveRibbonDistance (RTCScene scene, unsigned geomID, float distance);
+
 /*! \brief Creates a new line segment geometry, consisting of multiple
   segments with varying radii. The number of line segments (numSegments),
   number of vertices (numVertices), and number of time steps (1 for
@@ -417,6 +498,12 @@ RTCORE_API void rtcSetDisplacementFunction (RTCScene scene, unsigned geomID, RTC
 /*! \brief Sets the displacement function. */
 RTCORE_API void rtcSetDisplacementFunction2 (RTCScene scene, unsigned geomID, RTCDisplacementFunc2 func, RTCBounds* bounds);
 
+/*! \brief Sets a displacement function that displaces the grids of
+ *  multiple patches per invocation, which allows vectorizing
+ *  displacement over patches. Overrides displacement functions set
+ *  with rtcSetDisplacementFunction and rtcSetDisplacementFunction2. */
+RTCORE_API void rtcSetDisplacementBatchFunction (RTCScene scene, unsigned geomID, RTCDisplacementBatchFunc func, RTCBounds* bounds);
+
 /*! \brief Sets the intersection filter function for single rays. */
 RTCORE_API void rtcSetIntersectionFilterFunction (RTCScene scene, unsigned geomID, RTCFilterFunc func);
 
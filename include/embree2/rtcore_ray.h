@@ -268,6 +268,17 @@ public:
 };
 #endif
 
+/*! \brief Compact hit record written by rtcIntersectNpCompact. */
+#ifndef __RTCCompactHit__
+#define __RTCCompactHit__
+struct RTCCompactHit
+{
+  float t;           //!< hit distance (ray tfar if no hit was found)
+  unsigned primID;   //!< primitive ID
+  unsigned geomID;   //!< geometry ID (RTC_INVALID_GEOMETRY_ID if no hit was found)
+};
+#endif
+
 /* Helper functions to access hit packets of size N */
 #ifndef __RTCHitN__
 #define __RTCHitN__
@@ -26,6 +26,7 @@ struct RTCRay4;
 struct RTCRay8;
 struct RTCRay16;
 struct RTCRayNp;
+struct RTCCompactHit;
 
 /*! scene flags */
 enum RTCSceneFlags 
@@ -160,6 +161,16 @@ RTCORE_API void rtcIntersectNM (RTCScene scene, const RTCIntersectContext* conte
  *  of the ray packet. */
 RTCORE_API void rtcIntersectNp (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, const size_t N);
 
+/*! Intersects a stream of N rays in pointer SOA format with the
+ *  scene and writes only the hit distance, primitive ID and geometry
+ *  ID of each ray to the hits array. Only the ray data components of
+ *  the RTCRayNp structure are read, its hit data pointers are ignored
+ *  and may be NULL, and the ray data is not modified. Inactive rays
+ *  get RTC_INVALID_GEOMETRY_ID written as geometry ID. This function
+ *  can only be called for scenes with the RTC_INTERSECT_STREAM flag
+ *  set. */
+RTCORE_API void rtcIntersectNpCompact (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, RTCCompactHit* hits, const size_t N);
+
 /*! Tests if a single ray is occluded by the scene. The ray has to be
  *  aligned to 16 bytes. This function can only be called for scenes
  *  with the RTC_INTERSECT1 flag set. */
@@ -210,6 +221,16 @@ RTCORE_API void rtcOccludedNM (RTCScene scene, const RTCIntersectContext* contex
  *  of the ray packet. */
 RTCORE_API void rtcOccludedNp (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, const size_t N);
 
+/*! Tests if a stream of N rays in pointer SOA format is occluded by
+ *  the scene and writes the result as a packed bitmask. Bit (i%32) of
+ *  occluded[i/32] is set if ray i is occluded and cleared otherwise,
+ *  thus the occluded array has to provide (N+31)/32 entries. Only
+ *  the ray data components of the RTCRayNp structure are read, its
+ *  hit data pointers are ignored and may be NULL. Inactive rays are
+ *  reported as not occluded. This function can only be called for
+ *  scenes with the RTC_INTERSECT_STREAM flag set. */
+RTCORE_API void rtcOccludedNpMask (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, unsigned* occluded, const size_t N);
+
 /*! Deletes the scene. All contained geometry get also destroyed. */
 RTCORE_API void rtcDeleteScene (RTCScene scene);
 
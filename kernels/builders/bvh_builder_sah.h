@@ -241,8 +241,10 @@ namespace embree
             
           } while (numChildren < branchingFactor);
           
-          /* sort buildrecords for simpler shadow ray traversal */
-          std::sort(&children[0],&children[numChildren],std::greater<BuildRecord>()); // FIXME: reduces traversal performance of bvh8.triangle4 (need to verified) !!
+          /* sort buildrecords by increasing surface area, any hit traversal visits children in reverse order and thus enters the largest child first */
+          std::sort(&children[0],&children[numChildren],[] (const BuildRecord& a, const BuildRecord& b) {
+              return expectedApproxHalfArea(a.bounds()) < expectedApproxHalfArea(b.bounds());
+            });
           
           /*! create an inner node */
           auto node = createNode(current,children,numChildren,alloc);
@@ -188,6 +188,77 @@ namespace embree
                         TriangleSplitter(scene,prim).split(prim,dim,pos,lprim,rprim);
                       });
     }
+
+    template<>
+      inline const PrimInfo presplit<QuadMesh>(Scene* scene, const PrimInfo& pinfo, mvector<PrimRef>& prims)
+    {
+      return presplit(pinfo,prims, 
+                      [&] (const PrimRef& prim) -> float { 
+                        return area(prim.bounds());
+                      },
+                      [&] (const PrimRef& prim, const int dim, const float pos, PrimRef& lprim, PrimRef& rprim) {
+                        QuadSplitter(scene,prim).split(prim,dim,pos,lprim,rprim);
+                      });
+    }
+
+    template<>
+      inline const PrimInfo presplit<LineSegments>(Scene* scene, const PrimInfo& pinfo, mvector<PrimRef>& prims)
+    {
+      return presplit(pinfo,prims, 
+                      [&] (const PrimRef& prim) -> float { 
+                        return area(prim.bounds());
+                      },
+                      [&] (const PrimRef& prim, const int dim, const float pos, PrimRef& lprim, PrimRef& rprim) {
+                        LineSegmentsSplitter(scene,prim).split(prim,dim,pos,lprim,rprim);
+                      });
+    }
+
+    /*! presplits motion blurred primitives for the specified time
+     *  range, the bounds of the primitive references get replaced by the
+     *  bounds swept over the time range, such that the split references
+     *  bound the primitive at all times of the time range */
+    template<typename Mesh>
+      inline const PrimInfo presplitMBlurMesh(Scene* scene, const BBox1f& time_range, const PrimInfo& pinfo, mvector<PrimRef>& prims)
+    {
+      const PrimInfo sinfo = parallel_reduce (size_t(0), pinfo.size(), PrimInfo(empty), [&] (const range<size_t>& r) -> PrimInfo
+      {
+        PrimInfo pinfo(empty);
+        for (size_t i=r.begin(); i<r.end(); i++) {
+          const BBox3fa bounds = MBlurSplitter<Mesh>::bounds(scene,prims[i],time_range);
+          prims[i] = PrimRef(bounds,prims[i].geomID(),prims[i].primID());
+          pinfo.add(bounds);
+        }
+        return pinfo;
+      },[](const PrimInfo& a, const PrimInfo& b) { return PrimInfo::merge(a,b); });
+
+      return presplit(sinfo,prims, 
+                      [&] (const PrimRef& prim) -> float { 
+                        return area(prim.bounds());
+                      },
+                      [&] (const PrimRef& prim, const int dim, const float pos, PrimRef& lprim, PrimRef& rprim) {
+                        MBlurSplitter<Mesh>(scene,prim,time_range).split(prim,dim,pos,lprim,rprim);
+                      });
+    }
+  
+    template<typename Mesh>
+      inline const PrimInfo presplitMBlur(Scene* scene, const BBox1f& time_range, const PrimInfo& pinfo, mvector<PrimRef>& prims)
+    {
+      return pinfo;
+    }
+
+    template<>
+      inline const PrimInfo presplitMBlur<TriangleMesh>(Scene* scene, const BBox1f& time_range, const PrimInfo& pinfo, mvector<PrimRef>& prims) {
+      return presplitMBlurMesh<TriangleMesh>(scene,time_range,pinfo,prims);
+    }
+
+    template<>
+      inline const PrimInfo presplitMBlur<QuadMesh>(Scene* scene, const BBox1f& time_range, const PrimInfo& pinfo, mvector<PrimRef>& prims) {
+      return presplitMBlurMesh<QuadMesh>(scene,time_range,pinfo,prims);
+    }
+
+    template<>
+      inline const PrimInfo presplitMBlur<LineSegments>(Scene* scene, const BBox1f& time_range, const PrimInfo& pinfo, mvector<PrimRef>& prims) {
+      return presplitMBlurMesh<LineSegments>(scene,time_range,pinfo,prims);
+    }
   }
 }
-
@@ -34,6 +34,9 @@ namespace embree
     template<typename Mesh>
       PrimInfo createPrimRefArrayMBlur(size_t timeSegment, size_t numTimeSteps, Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
+    template<typename Mesh>
+      PrimInfo createPrimRefArrayMBlur(const BBox1f& time_range, Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+
     PrimInfo createBezierRefArray(Scene* scene, mvector<BezierPrim>& prims, BuildProgressMonitor& progressMonitor);
     PrimInfo createBezierRefArrayMBlur(size_t timeSegment, size_t numTimeSteps, Scene* scene, mvector<BezierPrim>& prims, BuildProgressMonitor& progressMonitor);
   }
@@ -175,6 +175,150 @@ namespace embree
     private:
       const Scene* scene;
     };
+
+    /*! splits the convex hull of a set of points enlarged by some radius */
+    __forceinline void splitPointSet(const PrimRef& prim, 
+                                     const size_t dim, 
+                                     const float pos, 
+                                     const Vec3fa* v, 
+                                     const size_t num,
+                                     const float radius,
+                                     PrimRef& left_o, 
+                                     PrimRef& right_o)
+    {
+      /* a point of the enlarged hull lies on the left side if its center is left of lpos */
+      const float lpos = pos+radius;
+      const float rpos = pos-radius;
+
+      BBox3fa left = empty, right = empty;
+      for (size_t i=0; i<num; i++)
+      {
+        const Vec3fa& v0 = v[i];
+        const float v0d = v0[dim];
+        if (v0d <= lpos) left. extend(v0); // this point is on left side
+        if (v0d >= rpos) right.extend(v0); // this point is on right side
+
+        /* the lines between all pairs of points cover the convex hull */
+        for (size_t j=i+1; j<num; j++)
+        {
+          const Vec3fa& v1 = v[j];
+          const float v1d = v1[dim];
+          if ((v0d < lpos && lpos < v1d) || (v1d < lpos && lpos < v0d)) 
+            left.extend(v0 + (lpos-v0d)/(v1d-v0d)*(v1-v0));
+          if ((v0d < rpos && rpos < v1d) || (v1d < rpos && rpos < v0d)) 
+            right.extend(v0 + (rpos-v0d)/(v1d-v0d)*(v1-v0));
+        }
+      }
+      left  = enlarge(left ,Vec3fa(radius)); left.upper[dim]  = min(left.upper[dim],pos);
+      right = enlarge(right,Vec3fa(radius)); right.lower[dim] = max(right.lower[dim],pos);
+
+      /* clip against current bounds */
+      new (&left_o ) PrimRef(intersect(left ,prim.bounds()),prim.geomID(), prim.primID());
+      new (&right_o) PrimRef(intersect(right,prim.bounds()),prim.geomID(), prim.primID());
+    }
+
+    struct LineSegmentsSplitter
+    {
+      __forceinline LineSegmentsSplitter(const Scene* scene, const PrimRef& prim)
+      {
+        const LineSegments* mesh = (const LineSegments*) scene->get(prim.geomID() & 0x00FFFFFF );  
+        const unsigned int index = mesh->segment(prim.primID());
+        v[0] = mesh->vertex(index+0);
+        v[1] = mesh->vertex(index+1);
+        radius = max(v[0].w,v[1].w);
+      }
+
+      __forceinline void split(const PrimRef& prim, const size_t dim, const float pos, PrimRef& left_o, PrimRef& right_o) const {
+        splitPointSet(prim,dim,pos,v,2,radius,left_o,right_o);
+      }
+
+    private:
+      Vec3fa v[2];
+      float radius;
+    };
+
+    /*! gathers the vertices of a primitive at the itime'th time step */
+    __forceinline size_t primitiveVertices(const TriangleMesh* mesh, size_t primID, size_t itime, Vec3fa* v, float& radius)
+    {
+      const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+      v[0] = mesh->vertex(tri.v[0],itime);
+      v[1] = mesh->vertex(tri.v[1],itime);
+      v[2] = mesh->vertex(tri.v[2],itime);
+      return 3;
+    }
+
+    __forceinline size_t primitiveVertices(const QuadMesh* mesh, size_t primID, size_t itime, Vec3fa* v, float& radius)
+    {
+      const QuadMesh::Quad& quad = mesh->quad(primID);
+      v[0] = mesh->vertex(quad.v[0],itime);
+      v[1] = mesh->vertex(quad.v[1],itime);
+      v[2] = mesh->vertex(quad.v[2],itime);
+      v[3] = mesh->vertex(quad.v[3],itime);
+      return 4;
+    }
+
+    __forceinline size_t primitiveVertices(const LineSegments* mesh, size_t primID, size_t itime, Vec3fa* v, float& radius)
+    {
+      const unsigned int index = mesh->segment(primID);
+      v[0] = mesh->vertex(index+0,itime);
+      v[1] = mesh->vertex(index+1,itime);
+      radius = max(radius,v[0].w,v[1].w);
+      return 2;
+    }
+
+    /*! splits a motion blurred primitive, as the primitive moves linearly
+     *  between its time steps, it stays inside the convex hull of its
+     *  vertices at all time steps overlapping the time range */
+    template<typename Mesh>
+    struct MBlurSplitter
+    {
+      static const size_t maxVertices = 32;
+
+      __forceinline MBlurSplitter(const Scene* scene, const PrimRef& prim, const BBox1f& time_range)
+        : num(0), radius(0.0f)
+      {
+        const Mesh* mesh = (const Mesh*) scene->get(prim.geomID() & 0x00FFFFFF );  
+        const float numTimeSegments = float(mesh->numTimeSteps-1);
+        const size_t itime0 = size_t(clamp(floor(time_range.lower*numTimeSegments),0.0f,numTimeSegments));
+        const size_t itime1 = size_t(clamp(ceil (time_range.upper*numTimeSegments),0.0f,numTimeSegments));
+        for (size_t itime=itime0; itime<=itime1; itime++) 
+        {
+          /* fall back to splitting the bounds only for primitives with many time steps */
+          if (num+4 > maxVertices) { num = 0; return; }
+          num += primitiveVertices(mesh,prim.primID(),itime,&v[num],radius);
+        }
+      }
+
+      /*! returns the bounds swept by the primitive over the time range */
+      static __forceinline BBox3fa bounds(const Scene* scene, const PrimRef& prim, const BBox1f& time_range)
+      {
+        const Mesh* mesh = (const Mesh*) scene->get(prim.geomID() & 0x00FFFFFF );  
+        const float numTimeSegments = float(mesh->numTimeSteps-1);
+        const size_t itime0 = size_t(clamp(floor(time_range.lower*numTimeSegments),0.0f,numTimeSegments));
+        const size_t itime1 = size_t(clamp(ceil (time_range.upper*numTimeSegments),0.0f,numTimeSegments));
+        BBox3fa bounds = empty;
+        for (size_t itime=itime0; itime<=itime1; itime++) 
+          bounds.extend(mesh->bounds(prim.primID(),itime));
+        return bounds;
+      }
+
+      __forceinline void split(const PrimRef& prim, const size_t dim, const float pos, PrimRef& left_o, PrimRef& right_o) const 
+      {
+        if (likely(num)) {
+          splitPointSet(prim,dim,pos,v,num,radius,left_o,right_o);
+          return;
+        }
+        BBox3fa left = prim.bounds(); left.upper[dim] = pos;
+        BBox3fa right = prim.bounds(); right.lower[dim] = pos;
+        new (&left_o ) PrimRef(left ,prim.geomID(), prim.primID());
+        new (&right_o) PrimRef(right,prim.geomID(), prim.primID());
+      }
+
+    private:
+      Vec3fa v[maxVertices];
+      size_t num;
+      float radius;
+    };
   }
 }
 
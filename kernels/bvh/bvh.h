@@ -1068,6 +1068,21 @@ namespace embree
       return roots[pre.itime(k)];
     }
 
+    /*! calculates the time segment of the ray if the time steps are non-uniformly distributed */
+    __forceinline void setTimeSegment(RayPrecalculations& pre, const Ray& ray) const {}
+
+    __forceinline void setTimeSegment(RayPrecalculationsMB& pre, const Ray& ray) const {
+      if (unlikely(timeSteps.size())) pre.setTimeSegment(ray.time,timeSteps.data(),numTimeSteps);
+    }
+
+    template<int K>
+    __forceinline void setTimeSegment(RayKPrecalculations<K>& pre, const RayK<K>& ray) const {}
+
+    template<int K>
+    __forceinline void setTimeSegment(RayKPrecalculationsMB<K>& pre, const RayK<K>& ray) const {
+      if (unlikely(timeSteps.size())) pre.setTimeSegment(ray.time,timeSteps.data(),numTimeSteps);
+    }
+
   public:
 
     /*! Encodes a node */
@@ -1135,6 +1150,7 @@ namespace embree
     NodeRef root;                      //!< root node
     bool msmblur;                      //!< when true root points to array of roots for MSMBlur mode
     unsigned numTimeSteps;             //!< number of time steps
+    std::vector<float> timeSteps;      //!< times of non-uniformly distributed time steps, empty if uniformly distributed
     FastAllocator alloc;               //!< allocator used to allocate nodes
 
     /*! statistics data */
@@ -26,6 +26,7 @@
 #include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglei.h"
+#include "../geometry/trianglem.h"
 #include "../geometry/trianglev_mb.h"
 #include "../geometry/trianglei_mb.h"
 #include "../geometry/quadv.h"
@@ -43,7 +44,6 @@ namespace embree
   namespace isa
   {
     MAYBE_UNUSED static const float travCost = 1.0f;
-    MAYBE_UNUSED static const float defaultPresplitFactor = 1.2f;
 
     typedef FastAllocator::ThreadLocal2 Allocator;
 
@@ -73,6 +73,40 @@ namespace embree
     };
 
 
+    /* meshlets store a varying number of triangles per block, thus the number of blocks depends on the triangles */
+    template<int N>
+    struct CreateLeaf<N,Triangle4m>
+    {
+      typedef BVHN<N> BVH;
+
+      __forceinline CreateLeaf (BVH* bvh, PrimRef* prims) : bvh(bvh), prims(prims) {}
+      
+      __forceinline size_t operator() (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc)
+      {
+        size_t n = current.prims.size();
+        size_t start = current.prims.begin();
+        size_t end = current.prims.end();
+
+        /* sort triangles by mesh and primitive ID to increase vertex sharing inside the meshlets */
+        std::sort(prims+start,prims+end,[] (const PrimRef& a, const PrimRef& b) {
+            return a.geomID() != b.geomID() ? a.geomID() < b.geomID() : a.primID() < b.primID();
+          });
+
+        size_t items = Triangle4m::blocks(prims,start,end,bvh->scene);
+        Triangle4m* accel = (Triangle4m*) alloc->alloc1->malloc(items*sizeof(Triangle4m),BVH::byteNodeAlignment);
+        typename BVH::NodeRef node = BVH::encodeLeaf((char*)accel,items);
+        for (size_t i=0; i<items; i++) {
+          accel[i].fill(prims,start,end,bvh->scene,false);
+        }
+        assert(start == end);
+        *current.parent = node;
+	return n;
+      }
+
+      BVH* bvh;
+      PrimRef* prims;
+    };
+
     template<int N, typename Primitive>
     struct CreateLeafQuantized
     {
@@ -157,12 +191,12 @@ namespace embree
 
       BVHNBuilderSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? bvh->scene->device->max_spatial_split_replications : 1.0f) {}
 
 
       BVHNBuilderSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY ) ? defaultPresplitFactor : 1.0f) {}
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? bvh->scene->device->max_spatial_split_replications : 1.0f) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -199,7 +233,7 @@ namespace embree
 
             /* perform pre-splitting */
             if (presplitFactor > 1.0f) 
-              pinfo = presplit<Mesh>(scene, pinfo, prims);
+              pinfo = presplit<Mesh>(bvh->scene, pinfo, prims);
         
             /* call BVH builder */            
             bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
@@ -246,11 +280,11 @@ namespace embree
 
       BVHNBuilderSAHQuantized (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? bvh->scene->device->max_spatial_split_replications : 1.0f) {}
 
       BVHNBuilderSAHQuantized (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? bvh->scene->device->max_spatial_split_replications : 1.0f) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -278,7 +312,7 @@ namespace embree
         
             /* perform pre-splitting */
             if (presplitFactor > 1.0f) 
-              pinfo = presplit<Mesh>(scene, pinfo, prims);
+              pinfo = presplit<Mesh>(bvh->scene, pinfo, prims);
         
             /* call BVH builder */
             bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
@@ -308,11 +342,25 @@ namespace embree
     /************************************************************************************/
     /************************************************************************************/
 
+    /* clips the linear bounds of a leaf against the bounds of its presplit primitive references, 
+     * per side the constant reference bound is used if it is tighter than the linear bound on average */
+    __forceinline LBBox3fa clipLinearBounds(const LBBox3fa& lbounds, const PrimRef* prims, const range<size_t>& r)
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=r.begin(); i<r.end(); i++) bounds.extend(prims[i].bounds());
+      const BBox3fa center = lbounds.interpolate(0.5f);
+      const Vec3ba clipLower = gt_mask(bounds.lower,center.lower);
+      const Vec3ba clipUpper = lt_mask(bounds.upper,center.upper);
+      const BBox3fa bounds0(select(clipLower,bounds.lower,lbounds.bounds0.lower),select(clipUpper,bounds.upper,lbounds.bounds0.upper));
+      const BBox3fa bounds1(select(clipLower,bounds.lower,lbounds.bounds1.lower),select(clipUpper,bounds.upper,lbounds.bounds1.upper));
+      return LBBox3fa(bounds0,bounds1);
+    }
+
     template<int N, typename Primitive>
     struct CreateMSMBlurLeaf
     {
       typedef BVHN<N> BVH;
-      __forceinline CreateMSMBlurLeaf (BVH* bvh, PrimRef* prims, size_t time) : bvh(bvh), prims(prims), time(time) {}
+      __forceinline CreateMSMBlurLeaf (BVH* bvh, PrimRef* prims, size_t time, bool clip) : bvh(bvh), prims(prims), time(time), clip(clip) {}
       
       __forceinline LBBox3fa operator() (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc)
       {
@@ -324,12 +372,40 @@ namespace embree
         for (size_t i=0; i<items; i++)
           allBounds.extend(accel[i].fillMB(prims, start, current.prims.end(), bvh->scene, false, time, bvh->numTimeSteps));
         *current.parent = node;
+        if (clip) return clipLinearBounds(allBounds,prims,current.prims);
         return allBounds;
       }
 
       BVH* bvh;
       PrimRef* prims;
       size_t time;
+      bool clip;
+    };
+
+    template<int N, typename Primitive>
+    struct CreateMSMBlurLeafTimeRange
+    {
+      typedef BVHN<N> BVH;
+      __forceinline CreateMSMBlurLeafTimeRange (BVH* bvh, PrimRef* prims, const BBox1f& time_range, bool clip) : bvh(bvh), prims(prims), time_range(time_range), clip(clip) {}
+      
+      __forceinline LBBox3fa operator() (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc)
+      {
+        size_t items = Primitive::blocks(current.prims.size());
+        size_t start = current.prims.begin();
+        Primitive* accel = (Primitive*) alloc->alloc1->malloc(items*sizeof(Primitive),BVH::byteNodeAlignment);
+        typename BVH::NodeRef node = bvh->encodeLeaf((char*)accel,items);
+        LBBox3fa allBounds = empty;
+        for (size_t i=0; i<items; i++)
+          allBounds.extend(accel[i].fillMB(prims, start, current.prims.end(), bvh->scene, false, time_range));
+        *current.parent = node;
+        if (clip) return clipLinearBounds(allBounds,prims,current.prims);
+        return allBounds;
+      }
+
+      BVH* bvh;
+      PrimRef* prims;
+      BBox1f time_range;
+      bool clip;
     };
 
     template<int N, typename Mesh, typename Primitive>
@@ -344,10 +420,12 @@ namespace embree
       const float intCost;
       const size_t minLeafSize;
       const size_t maxLeafSize;
+      const float presplitFactor;
 
-      BVHNBuilderMSMBlurSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize)
+      BVHNBuilderMSMBlurSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), prims(scene->device), 
-          sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)) {}
+          sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? bvh->scene->device->max_spatial_split_replications : 1.0f) {}
 
       void build(size_t, size_t) 
       {
@@ -361,12 +439,60 @@ namespace embree
         }      
 
         double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderMSMBlurSAH");
-	
+
+        /* geometries with different number of time steps get split in time */
+        std::vector<float> times = timeSteps();
+        if (times.size())
+          buildTimeSplit(times);
+        else
+          buildUniform();
+
+	/* clear temporary data for static geometry */
+	if (scene->isStatic()) 
+        {
+          prims.clear();
+          bvh->shrink();
+        }
+	bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      /* returns the union of the time steps of all geometries, or an empty vector if all time steps lie on a uniform grid */
+      std::vector<float> timeSteps()
+      {
+        std::vector<float> times;
+        Scene::Iterator<Mesh,true> iter(scene);
+        size_t maxTimeSegments = 1;
+        for (size_t i=0; i<iter.size(); i++)
+        {
+          Mesh* mesh = iter.at(i);
+          if (mesh == nullptr) continue;
+          const size_t numTimeSegments = mesh->numTimeSteps-1;
+          maxTimeSegments = max(maxTimeSegments,numTimeSegments);
+          for (size_t j=0; j<=numTimeSegments; j++)
+            times.push_back(float(j)/float(numTimeSegments));
+        }
+        std::sort(times.begin(),times.end());
+        times.erase(std::unique(times.begin(),times.end()),times.end());
+
+        /* all time steps lie on the grid of the geometry with the most time steps */
+        if (times.size() == maxTimeSegments+1 || times.size() > RTC_MAX_TIME_STEPS)
+          times.clear();
+
+        return times;
+      }
+
+      /* builds one BVH for each time segment of the geometry with the most time steps */
+      void buildUniform()
+      {
         /* allocate buffers */
+        const size_t numPrimitives = scene->getNumPrimitives<Mesh,true>();
+        bvh->timeSteps.clear();
         bvh->numTimeSteps = scene->getNumTimeSteps<Mesh,true>();
         const size_t numTimeSegments = bvh->numTimeSteps-1; assert(bvh->numTimeSteps > 1);
-        prims.resize(numPrimitives);
-        bvh->alloc.init_estimate(numPrimitives*sizeof(PrimRef)*numTimeSegments);
+        const size_t numSplitPrimitives = max(numPrimitives,size_t(presplitFactor*numPrimitives));
+        prims.resize(numSplitPrimitives);
+        bvh->alloc.init_estimate(numSplitPrimitives*sizeof(PrimRef)*numTimeSegments);
         NodeRef* roots = (NodeRef*) bvh->alloc.threadLocal2()->alloc0->malloc(sizeof(NodeRef)*numTimeSegments,BVH::byteNodeAlignment);
 
         /* build BVH for each timestep */
@@ -376,10 +502,15 @@ namespace embree
         {
           /* call BVH builder */
           NodeRef root; LBBox3fa tbounds;
-          const PrimInfo pinfo = createPrimRefArrayMBlur<Mesh>(t,bvh->numTimeSteps,scene,prims,bvh->scene->progressInterface);
+          PrimInfo pinfo = createPrimRefArrayMBlur<Mesh>(t,bvh->numTimeSteps,scene,prims,bvh->scene->progressInterface);
+
+          /* perform pre-splitting */
+          if (presplitFactor > 1.0f && pinfo.size())
+            pinfo = presplitMBlur<Mesh>(bvh->scene,BBox1f(float(t+0)/float(numTimeSegments),float(t+1)/float(numTimeSegments)),pinfo,prims);
+
           if (pinfo.size())
           {
-            std::tie(root, tbounds) = BVHNBuilderMblur<N>::build(bvh,CreateMSMBlurLeaf<N,Primitive>(bvh,prims.data(),t),bvh->scene->progressInterface,prims.data(),pinfo,
+            std::tie(root, tbounds) = BVHNBuilderMblur<N>::build(bvh,CreateMSMBlurLeaf<N,Primitive>(bvh,prims.data(),t,presplitFactor > 1.0f),bvh->scene->progressInterface,prims.data(),pinfo,
                                                                  sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
           }
           else
@@ -394,15 +525,102 @@ namespace embree
         }
         bvh->set(NodeRef((size_t)roots),LBBox3fa(bounds),num_bvh_primitives);
         bvh->msmblur = true;
+      }
 
-	/* clear temporary data for static geometry */
-	if (scene->isStatic()) 
+      /* creates the primitive references for some time range and returns its SAH cost */
+      float primRefCost(const BBox1f& time_range, PrimInfo& pinfo)
+      {
+        pinfo = createPrimRefArrayMBlur<Mesh>(time_range,scene,prims,bvh->scene->progressInterface);
+        const float area = parallel_reduce(size_t(0),pinfo.size(),size_t(1024),0.0f,[&] (const range<size_t>& r) -> float {
+            float area = 0.0f;
+            for (size_t i=r.begin(); i<r.end(); i++) area += halfArea(prims[i].bounds());
+            return area;
+          }, std::plus<float>());
+        return time_range.size()*area;
+      }
+
+      /* recursively splits the time steps [begin,end] while this reduces the SAH cost of all BVHs */
+      void splitTimeRange(const std::vector<float>& times, size_t begin, size_t end, float cost, std::vector<size_t>& splits)
+      {
+        if (end-begin > 1)
         {
-          prims.clear();
-          bvh->shrink();
+          const size_t center = (begin+end)/2;
+          PrimInfo pinfo(empty);
+          const float lcost = primRefCost(BBox1f(times[begin],times[center]),pinfo);
+          const float rcost = primRefCost(BBox1f(times[center],times[end]),pinfo);
+          if (lcost+rcost < 0.99f*cost)
+          {
+            splitTimeRange(times,begin,center,lcost,splits);
+            splitTimeRange(times,center,end,rcost,splits);
+            return;
+          }
         }
-	bvh->cleanup();
-        bvh->postBuild(t0);
+        splits.push_back(end);
+      }
+
+      /* builds one BVH for each time range found by a temporal SAH over the union of the time steps of all geometries */
+      void buildTimeSplit(const std::vector<float>& times)
+      {
+        const size_t numPrimitives = scene->getNumPrimitives<Mesh,true>();
+        const size_t numSplitPrimitives = max(numPrimitives,size_t(presplitFactor*numPrimitives));
+        prims.resize(numSplitPrimitives);
+
+        /* find time ranges to build separate BVHs for */
+        PrimInfo pinfo(empty);
+        std::vector<size_t> splits(1,0);
+        splitTimeRange(times,0,times.size()-1,primRefCost(BBox1f(0.0f,1.0f),pinfo),splits);
+        const size_t numTimeSegments = splits.size()-1;
+        bvh->alloc.init_estimate(numSplitPrimitives*sizeof(PrimRef)*numTimeSegments);
+        NodeRef* roots = (NodeRef*) bvh->alloc.threadLocal2()->alloc0->malloc(sizeof(NodeRef)*numTimeSegments,BVH::byteNodeAlignment);
+
+        /* build BVH for each time range */
+        avector<BBox3fa> bounds(numTimeSegments+1);
+        for (size_t t=0; t<=numTimeSegments; t++) bounds[t] = empty;
+        bvh->timeSteps.resize(numTimeSegments+1);
+        size_t num_bvh_primitives = 0;
+        for (size_t t=0; t<numTimeSegments; t++)
+        {
+          /* call BVH builder */
+          NodeRef root; LBBox3fa tbounds;
+          const BBox1f time_range(times[splits[t]],times[splits[t+1]]);
+          PrimInfo pinfo = createPrimRefArrayMBlur<Mesh>(time_range,scene,prims,bvh->scene->progressInterface);
+
+          /* perform pre-splitting */
+          if (presplitFactor > 1.0f && pinfo.size())
+            pinfo = presplitMBlur<Mesh>(bvh->scene,time_range,pinfo,prims);
+
+          if (pinfo.size())
+          {
+            std::tie(root, tbounds) = BVHNBuilderMblur<N>::build(bvh,CreateMSMBlurLeafTimeRange<N,Primitive>(bvh,prims.data(),time_range,presplitFactor > 1.0f),bvh->scene->progressInterface,prims.data(),pinfo,
+                                                                 sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+          }
+          else
+          {
+            tbounds = LBBox3fa(empty);
+            root = BVH::emptyNode;
+          }
+          roots[t] = root;
+          bounds[t+0].extend(tbounds.bounds0);
+          bounds[t+1].extend(tbounds.bounds1);
+          bvh->timeSteps[t+0] = time_range.lower;
+          bvh->timeSteps[t+1] = time_range.upper;
+          num_bvh_primitives = max(num_bvh_primitives,pinfo.size());
+        }
+
+        /* conservatively fit linear bounds through the bounds at the non-uniform time steps */
+        BBox3fa b0 = bounds.front(), b1 = bounds.back();
+        for (size_t i=1; i<numTimeSegments; i++)
+        {
+          const BBox3fa bt = lerp(b0,b1,bvh->timeSteps[i]);
+          const Vec3fa dlower = min(bounds[i].lower-bt.lower,Vec3fa(zero));
+          const Vec3fa dupper = max(bounds[i].upper-bt.upper,Vec3fa(zero));
+          b0.lower += dlower; b1.lower += dlower;
+          b0.upper += dupper; b1.upper += dupper;
+        }
+
+        bvh->numTimeSteps = unsigned(numTimeSegments+1);
+        bvh->set(NodeRef((size_t)roots),LBBox3fa(b0,b1),num_bvh_primitives);
+        bvh->msmblur = true;
       }
 
       void clear() {
@@ -584,12 +802,12 @@ namespace embree
 
       BVHNBuilderSweepSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? bvh->scene->device->max_spatial_split_replications : 1.0f) {}
 
 
       BVHNBuilderSweepSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY ) ? defaultPresplitFactor : 1.0f) {}
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? bvh->scene->device->max_spatial_split_replications : 1.0f) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -618,7 +836,7 @@ namespace embree
         
             /* perform pre-splitting */
             if (presplitFactor > 1.0f) 
-              pinfo = presplit<Mesh>(scene, pinfo, prims);
+              pinfo = presplit<Mesh>(bvh->scene, pinfo, prims);
         
             /* call BVH builder */
             bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
@@ -652,10 +870,10 @@ namespace embree
 #if defined(EMBREE_GEOMETRY_LINES)
     Builder* BVH4Line4iMeshBuilderSAH     (void* bvh, LineSegments* mesh, size_t mode) { return new BVHNBuilderSAH<4,LineSegments,Line4i>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH4Line4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,LineSegments,Line4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
-    Builder* BVH4Line4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<4,LineSegments,Line4i>((BVH4*)bvh,scene ,4,1.0f,4,inf); }
+    Builder* BVH4Line4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<4,LineSegments,Line4i>((BVH4*)bvh,scene ,4,1.0f,4,inf,mode); }
 #if defined(__AVX__)
     Builder* BVH8Line4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,LineSegments,Line4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
-    Builder* BVH8Line4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<8,LineSegments,Line4i>((BVH8*)bvh,scene,4,1.0f,4,inf); }
+    Builder* BVH8Line4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<8,LineSegments,Line4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
 #endif
 #endif
 
@@ -668,13 +886,15 @@ namespace embree
     Builder* BVH4Triangle4MeshBuilderSAH  (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4vMeshBuilderSAH (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4v>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4iMeshBuilderSAH (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4i>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
+    Builder* BVH4Triangle4mMeshBuilderSAH (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4m>((BVH4*)bvh,mesh,4,1.0f,4,BVH4::maxLeafBlocks,mode); }
     
     Builder* BVH4Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4Triangle4mSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4m>((BVH4*)bvh,scene,4,1.0f,4,BVH4::maxLeafBlocks,mode); }
 
-    Builder* BVH4Triangle4vMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMSMBlurSAH<4,TriangleMesh,Triangle4vMB>((BVH4*)bvh,scene,4,1.0f,4,inf); }
-    Builder* BVH4Triangle4iMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMSMBlurSAH<4,TriangleMesh,Triangle4iMB>((BVH4*)bvh,scene,4,1.0f,4,inf); }
+    Builder* BVH4Triangle4vMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMSMBlurSAH<4,TriangleMesh,Triangle4vMB>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4Triangle4iMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMSMBlurSAH<4,TriangleMesh,Triangle4iMB>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 
     Builder* BVH4Triangle4SceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,TriangleMesh,Triangle4,TriangleSplitterFactory>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4vSceneBuilderFastSpatialSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,TriangleMesh,Triangle4v,TriangleSplitterFactory>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
@@ -690,8 +910,8 @@ namespace embree
     Builder* BVH8Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4vSceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
-    Builder* BVH8Triangle4vMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMSMBlurSAH<8,TriangleMesh,Triangle4vMB>((BVH8*)bvh,scene,4,1.0f,4,inf); }
-    Builder* BVH8Triangle4iMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMSMBlurSAH<8,TriangleMesh,Triangle4iMB>((BVH8*)bvh,scene,4,1.0f,4,inf); }
+    Builder* BVH8Triangle4vMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMSMBlurSAH<8,TriangleMesh,Triangle4vMB>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH8Triangle4iMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMSMBlurSAH<8,TriangleMesh,Triangle4iMB>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8QuantizedTriangle4iSceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,TriangleMesh,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4SceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,TriangleMesh,Triangle4,TriangleSplitterFactory>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4vSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,TriangleMesh,Triangle4v,TriangleSplitterFactory>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
@@ -707,7 +927,7 @@ namespace embree
     Builder* BVH4Quad4iMeshBuilderSAH     (void* bvh, QuadMesh* mesh, size_t mode)     { return new BVHNBuilderSAH<4,QuadMesh,Quad4i>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH4Quad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Quad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
-    Builder* BVH4Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<4,QuadMesh,Quad4iMB>((BVH4*)bvh,scene ,4,1.0f,4,inf); }
+    Builder* BVH4Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<4,QuadMesh,Quad4iMB>((BVH4*)bvh,scene ,4,1.0f,4,inf,mode); }
     Builder* BVH4QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Quad4vSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,QuadMesh,Quad4v,QuadSplitterFactory>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
@@ -715,7 +935,7 @@ namespace embree
 #if defined(__AVX__)
     Builder* BVH8Quad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,QuadMesh,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Quad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,QuadMesh,Quad4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
-    Builder* BVH8Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<8,QuadMesh,Quad4iMB>((BVH8*)bvh,scene,4,1.0f,4,inf); }
+    Builder* BVH8Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<8,QuadMesh,Quad4iMB>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,QuadMesh,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,QuadMesh,Quad4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Quad4vMeshBuilderSAH     (void* bvh, QuadMesh* mesh, size_t mode)     { return new BVHNBuilderSAH<8,QuadMesh,Quad4v>((BVH8*)bvh,mesh,4,1.0f,4,inf,mode); }
@@ -739,7 +959,7 @@ namespace embree
     Builder* BVH4VirtualMBSceneBuilderSAH    (void* bvh, Scene* scene, size_t mode) {
       int minLeafSize = scene->device->object_accel_mb_min_leaf_size;
       int maxLeafSize = scene->device->object_accel_mb_max_leaf_size;
-      return new BVHNBuilderMSMBlurSAH<4,AccelSet,Object>((BVH4*)bvh,scene,4,1.0f,minLeafSize,maxLeafSize);
+      return new BVHNBuilderMSMBlurSAH<4,AccelSet,Object>((BVH4*)bvh,scene,4,1.0f,minLeafSize,maxLeafSize,0); // user geometry cannot get presplit
     }
 #endif
   }
@@ -55,13 +55,17 @@ namespace embree
 
 #define SUBGRID 9
 
+      /*! maximal number of patches whose grids get displaced in one batch */
+      static const size_t MAX_BATCH_PATCHES = 256;
+
       static unsigned getNumEagerLeaves(unsigned width, unsigned height) {
         const unsigned w = (width+SUBGRID-1)/SUBGRID;
         const unsigned h = (width+SUBGRID-1)/SUBGRID;
         return w*h;
       }
 
-      __forceinline static unsigned createEager(SubdivPatch1Base& patch, Scene* scene, SubdivMesh* mesh, unsigned primID, FastAllocator::ThreadLocal& alloc, PrimRef* prims)
+      __forceinline static unsigned createEager(SubdivPatch1Base& patch, Scene* scene, SubdivMesh* mesh, unsigned primID, FastAllocator::ThreadLocal& alloc, PrimRef* prims,
+                                                const GridBatch* batch = nullptr, size_t batchIndex = 0)
       {
         unsigned NN = 0;
         const unsigned x0 = 0, x1 = patch.grid_u_res-1;
@@ -74,7 +78,7 @@ namespace embree
             const unsigned lx0 = x, lx1 = min(lx0+SUBGRID-1,x1);
             const unsigned ly0 = y, ly1 = min(ly0+SUBGRID-1,y1);
             BBox3fa bounds;
-            GridSOA* leaf = GridSOA::create(&patch,1,1,lx0,lx1,ly0,ly1,scene,alloc,&bounds);
+            GridSOA* leaf = GridSOA::create(&patch,1,1,lx0,lx1,ly0,ly1,scene,alloc,&bounds,batch,batchIndex);
             *prims = PrimRef(bounds,BVH4::encodeTypedLeaf(leaf,1)); prims++;
             NN++;
           }
@@ -111,6 +115,14 @@ namespace embree
         Scene::Iterator<SubdivMesh> iter(scene);
         pstate.init(iter,size_t(1024));
 
+        /* calculate edge levels from tessellation cameras, has to happen in a separate pass as patches read edge levels of neighboring faces */
+        parallel_for_for( iter, size_t(1024), [&](SubdivMesh* mesh, const range<size_t>& r, size_t k)
+        {
+          if (!mesh->hasTessellationCameras()) return;
+          for (size_t f=r.begin(); f!=r.end(); ++f)
+            mesh->updateCameraEdgeLevels(f);
+        });
+
         PrimInfo pinfo1 = parallel_for_for_prefix_sum( pstate, iter, PrimInfo(empty), [&](SubdivMesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo
         { 
           size_t p = 0;
@@ -145,11 +157,39 @@ namespace embree
           FastAllocator::ThreadLocal& alloc = *bvh->alloc.threadLocal();
           
           PrimInfo s(empty);
+
+          /* with a batched displacement function the patches are
+           * collected and their grids displaced together before the
+           * leaves get created */
+          const bool batched = GridBatch::enabled(mesh);
+          GridBatch batch(mesh);
+          SubdivPatch1Base* patches = batched ? (SubdivPatch1Base*) alignedMalloc(MAX_BATCH_PATCHES*sizeof(SubdivPatch1Base),64) : nullptr;
+          auto flush = [&] () 
+          {
+            batch.eval();
+            for (size_t j=0; j<batch.size(); j++) 
+            {
+              size_t num = createEager(patches[j],scene,mesh,patches[j].prim,alloc,&prims[base.end+s.end],&batch,j);
+              assert(num == getNumEagerLeaves(patches[j].grid_u_res,patches[j].grid_v_res));
+              for (size_t i=0; i<num; i++)
+                s.add(prims[base.end+s.end].bounds());
+              s.begin++;
+            }
+            batch.clear();
+          };
+
           for (size_t f=r.begin(); f!=r.end(); ++f) {
             if (!mesh->valid(f)) continue;
             
             patch_eval_subdivision(mesh->getHalfEdge(f),[&](const Vec2f uv[4], const int subdiv[4], const float edge_level[4], int subPatch)
             {
+              if (batched) 
+              {
+                SubdivPatch1Base* patch = new (&patches[batch.size()]) SubdivPatch1Base(mesh->id,unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
+                batch.add(*patch);
+                if (batch.full() || batch.size() == MAX_BATCH_PATCHES) flush();
+                return;
+              }
               SubdivPatch1Base patch(mesh->id,unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
               size_t num = createEager(patch,scene,mesh,unsigned(f),alloc,&prims[base.end+s.end]);
               assert(num == getNumEagerLeaves(patch.grid_u_res,patch.grid_v_res));
@@ -158,6 +198,11 @@ namespace embree
               s.begin++;
             });
           }
+
+          if (batched) {
+            flush();
+            alignedFree(patches);
+          }
           return s;
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a, b); });
 
@@ -235,15 +280,8 @@ namespace embree
             for (size_t i=range.begin(); i<range.end(); i++)
             {
               if (!iter[i]) continue;
-              fastUpdate &= !iter[i]->vertexIndices.isModified(); 
-              fastUpdate &= !iter[i]->faceVertices.isModified();
-              fastUpdate &= !iter[i]->holes.isModified();
-              fastUpdate &= !iter[i]->edge_creases.isModified();
-              fastUpdate &= !iter[i]->edge_crease_weights.isModified();
-              fastUpdate &= !iter[i]->vertex_creases.isModified();
-              fastUpdate &= !iter[i]->vertex_crease_weights.isModified(); 
-              fastUpdate &= iter[i]->levels.isModified();
               iter[i]->initializeHalfEdgeStructures();
+              fastUpdate &= iter[i]->checkTopologyUpdate(); // only vertex positions, creases, or edge levels changed
               //iter[i]->patch_eval_trees.resize(iter[i]->size()*numTimeSteps);
             }
             return fastUpdate;
@@ -265,8 +303,11 @@ namespace embree
         { 
           size_t s = 0;
           size_t sMB = 0;
+          const bool cameraLevels = mesh->hasTessellationCameras();
           for (size_t f=r.begin(); f!=r.end(); ++f) 
           {          
+            /* edge levels from tessellation cameras are calculated here as counting patches does not depend on them */
+            if (cameraLevels) mesh->updateCameraEdgeLevels(f);
             if (!mesh->valid(f)) continue;
             size_t count = patch_eval_subdivision_count(mesh->getHalfEdge(f));
             s += count;
@@ -321,6 +362,32 @@ namespace embree
         {
           size_t s = 0;
           size_t sMB = 0;
+
+          /* with a batched displacement function the grids of multiple
+           * patches get displaced together, patches are stored at their
+           * final location already */
+          const bool batched = GridBatch::enabled(mesh);
+          GridBatch batch(mesh);
+          std::vector<size_t> batchPatches;
+          auto flush = [&] ()
+          {
+            batch.eval();
+            BVH_Allocator alloc(bvh);
+            for (size_t j=0, index=0; j<batchPatches.size(); j++, index+=mesh->numTimeSteps)
+            {
+              const size_t patchIndexMB = batchPatches[j];
+              if (cached) {
+                for (size_t t=0; t<mesh->numTimeSteps; t++)
+                  bounds[patchIndexMB+t] = batch.bounds(index+t);
+              } else {
+                SubdivPatch1Base& patch0 = subdiv_patches[patchIndexMB];
+                patch0.root_ref.set((int64_t) GridSOA::create(&patch0,(unsigned)mesh->numTimeSteps,(unsigned)numTimeSteps,scene,alloc,&bounds[patchIndexMB],&batch,index));
+              }
+            }
+            batch.clear();
+            batchPatches.clear();
+          };
+
           for (size_t f=r.begin(); f!=r.end(); ++f) 
           {
             if (!mesh->valid(f)) continue;
@@ -341,7 +408,14 @@ namespace embree
                 new (&patch) SubdivPatch1Cached(mesh->id,unsigned(f),subPatch,mesh,t,uv,edge_level,subdiv,VSIZEX);
               }
 
-              if (cached)
+              if (batched)
+              {
+                for (size_t t=0; t<mesh->numTimeSteps; t++)
+                  batch.add(subdiv_patches[patchIndexMB+t]);
+                batchPatches.push_back(patchIndexMB);
+                if (batch.full()) flush();
+              }
+              else if (cached)
               {
                 for (size_t t=0; t<mesh->numTimeSteps; t++)
                 {
@@ -361,9 +435,14 @@ namespace embree
               sMB += mesh->numTimeSteps;
             });
           }
+          if (batched) flush();
           return PrimInfo(s,sMB,empty,empty);
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo(a.begin+b.begin,a.end+b.end,empty,empty); });
 
+        /* mark the end of the patch array, grid prefetching stops there */
+        const size_t numPatchesMB = bvh->subdiv_patches.size()/sizeof(SubdivPatch1Cached);
+        subdiv_patches[numPatchesMB-1].flags |= SubdivPatch1Base::LAST_PATCH;
+
         auto virtualprogress = BuildProgressMonitorFromClosure([&] (size_t dn) { 
             //bvh->scene->progressMonitor(double(dn)); // FIXME: triggers GCC compiler bug
           });
@@ -445,8 +524,12 @@ namespace embree
               SubdivPatch1Base& patch = subdiv_patches[patchIndex];
               BBox3fa bound = empty;
               
-              bool grid_changed = patch.updateEdgeLevels(edge_level,subdiv,mesh,VSIZEX);
-              if (grid_changed) {
+              /* the patch of a face with moved vertices gets recreated in place, which also invalidates its cached grid */
+              if (mesh->faceModified(f)) {
+                new (&patch) SubdivPatch1Cached(mesh->id,unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
+                bound = evalGridBounds(patch,0,patch.grid_u_res-1,0,patch.grid_v_res-1,patch.grid_u_res,patch.grid_v_res,mesh);
+              }
+              else if (patch.updateEdgeLevels(edge_level,subdiv,mesh,VSIZEX)) {
                 patch.resetRootRef();
                 bound = evalGridBounds(patch,0,patch.grid_u_res-1,0,patch.grid_v_res-1,patch.grid_u_res,patch.grid_v_res,mesh);
               }
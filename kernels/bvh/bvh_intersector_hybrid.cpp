@@ -23,6 +23,7 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/trianglem_intersector.h"
 #include "../geometry/trianglei_mb_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
@@ -57,6 +58,7 @@ namespace embree
 
       /* if the rays belong to different time segments, immediately switch to single ray traversal */
       Precalculations pre(valid,ray,bvh->numTimeSteps);
+      bvh->setTimeSegment(pre,ray);
       size_t valid_bits = movemask(valid);
       const size_t valid_first = __bsf(valid_bits);
       if (unlikely((types & BVH_MB) && valid_bits && (movemask(pre.itime() == pre.itime(valid_first)) != valid_bits)))
@@ -268,6 +270,7 @@ namespace embree
 
       /* if the rays belong to different time segments, immediately switch to single ray traversal */
       Precalculations pre(valid,ray,bvh->numTimeSteps);
+      bvh->setTimeSegment(pre,ray);
       size_t valid_bits = movemask(valid);
       const size_t valid_first = __bsf(valid_bits);
       if (unlikely((types & BVH_MB) && valid_bits && (movemask(pre.itime() == pre.itime(valid_first)) != valid_bits)))
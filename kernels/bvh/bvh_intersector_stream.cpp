@@ -23,6 +23,7 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/trianglem_intersector.h"
 #include "../geometry/trianglei_mb_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
@@ -382,6 +383,7 @@ namespace embree
         for (size_t i = 0; i < numOctantRays; i++) {
           new (&ray_ctx[i]) RayCtx(rays[i]);
           new (&pre[i]) Precalculations(*rays[i], bvh, bvh->numTimeSteps);
+          bvh->setTimeSegment(pre[i],*rays[i]);
         }
 
         stack[0].ptr  = BVH::invalidNode;
@@ -502,6 +504,7 @@ namespace embree
         for (size_t i = 0; i < numOctantRays; i++) {
           new (&ray_ctx[i]) RayCtx(rays[i]);
           new (&pre[i]) Precalculations(*rays[i], bvh, bvh->numTimeSteps);
+          bvh->setTimeSegment(pre[i],*rays[i]);
         }
 
         stack[0].ptr  = BVH::invalidNode;
@@ -588,10 +591,18 @@ namespace embree
                                     TriangleMiIntersector1Moeller<SIMD_MODE(4) COMMA true >,
                                     TriangleMiIntersectorKMoeller<4 COMMA VSIZEX COMMA VSIZEX COMMA true > > Triangle4iIntersectorStreamMoeller;
 
+    typedef ArrayIntersectorKStream<VSIZEX,
+                                    TriangleMmIntersector1Moeller<SIMD_MODE(4) COMMA true >,
+                                    TriangleMmIntersectorKMoeller<4 COMMA VSIZEX COMMA VSIZEX COMMA true > > Triangle4mIntersectorStreamMoeller;
+
     typedef ArrayIntersectorKStream<VSIZEX,
                                     TriangleMiIntersector1Pluecker<SIMD_MODE(4) COMMA true >,
                                     TriangleMiIntersectorKPluecker<4 COMMA VSIZEX COMMA VSIZEX COMMA true > > Triangle4iIntersectorStreamPluecker;
 
+    typedef ArrayIntersectorKStream<VSIZEX,
+                                    TriangleMmIntersector1Pluecker<SIMD_MODE(4) COMMA true >,
+                                    TriangleMmIntersectorKPluecker<4 COMMA VSIZEX COMMA VSIZEX COMMA true > > Triangle4mIntersectorStreamPluecker;
+
     typedef ArrayIntersectorKStream<VSIZEX,
                                     QuadMvIntersector1Moeller<4 COMMA true >,
                                     QuadMvIntersectorKMoeller<4 COMMA VSIZEX COMMA true > > Quad4vIntersectorStreamMoeller;
@@ -629,8 +640,10 @@ namespace embree
     IF_ENABLED_HAIR(DEFINE_INTERSECTORN(BVH4Bezier1iIntersectorStream,BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
     
     IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4iIntersectorStreamMoeller,        BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA false COMMA Triangle4iIntersectorStreamMoeller>));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4mIntersectorStreamMoeller,        BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA false COMMA Triangle4mIntersectorStreamMoeller>));
     IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4vIntersectorStreamPluecker,       BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA true  COMMA Triangle4vIntersectorStreamPluecker>));
     IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4iIntersectorStreamPluecker,       BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA true  COMMA Triangle4iIntersectorStreamPluecker>));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4mIntersectorStreamPluecker,       BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA true  COMMA Triangle4mIntersectorStreamPluecker>));
     IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4IntersectorStreamMoeller,         BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA false COMMA Triangle4IntersectorStreamMoeller>));
     IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4IntersectorStreamMoellerNoFilter, BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA false COMMA Triangle4IntersectorStreamMoellerNoFilter>));
     
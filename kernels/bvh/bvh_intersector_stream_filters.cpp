@@ -16,6 +16,7 @@
 
 #include "bvh_intersector_stream_filters.h"
 #include "bvh_intersector_stream.h"
+#include "../../include/embree2/rtcore_ray.h"
 
 namespace embree
 {
@@ -331,9 +332,14 @@ namespace embree
         }
     }
 
-    void RayStream::filterSOP(Scene *scene, const RTCRayNp& _rayN, const size_t N, IntersectContext* context, const bool intersect)
+    /*! traces a stream of rays in pointer SOA layout, the scatterK and
+     *  scatter1 functions write back the results of packets and single
+     *  rays, the skip1 function is invoked for inactive rays of the
+     *  stream path */
+    template<typename ScatterK, typename Scatter1, typename Skip1>
+    static __forceinline void traceSOP(Scene *scene, RayPN& rayN, const size_t N, IntersectContext* context, const bool intersect,
+                                       const ScatterK& scatterK, const Scatter1& scatter1, const Skip1& skip1)
     {
-      RayPN& rayN = *(RayPN*)&_rayN;
       size_t rayStartIndex = 0;
 
       /* use packet intersector for coherent ray mode */
@@ -346,13 +352,13 @@ namespace embree
         for (size_t i=0; i<numPackets * VSIZEX; i+=VSIZEX)
         {
           const vintx vi = vintx(int(i))+vintx(step);
-          vboolx valid = vi < vintx(int(N));
+          const vboolx valid = vi < vintx(int(N));
           const size_t offset = s*stream_offset + sizeof(float) * i;
           RayK<VSIZEX> ray = rayN.gather<VSIZEX>(valid,offset);
-          valid &= ray.tnear <= ray.tfar;
-          if (intersect) scene->intersect(valid,ray,context);
-          else           scene->occluded (valid,ray,context);
-          rayN.scatter<VSIZEX>(valid,offset,ray,intersect);
+          const vboolx active = valid & (ray.tnear <= ray.tfar);
+          if (intersect) scene->intersect(active,ray,context);
+          else           scene->occluded (active,ray,context);
+          scatterK(valid,active,offset,ray);
         }
         return;
       }
@@ -373,11 +379,11 @@ namespace embree
           /* global + local offset */
           const size_t offset = sizeof(float) * i;
 
-          if (unlikely(!rayN.isValidByOffset(offset))) continue;
+          if (unlikely(!rayN.isValidByOffset(offset))) { skip1(offset); continue; }
 
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
           __aligned(64) Ray ray = rayN.gatherByOffset(offset);
-          if (unlikely(!ray.valid())) continue; 
+          if (unlikely(!ray.valid())) { skip1(offset); continue; }
 #endif
 
           const size_t octantID = rayN.getOctantByOffset(offset);
@@ -399,7 +405,7 @@ namespace embree
               scene->occludedN((RTCRay**)rays_ptr,MAX_RAYS_PER_OCTANT,context);
 
             for (size_t j=0;j<MAX_RAYS_PER_OCTANT;j++)
-              rayN.scatterByOffset(octants[octantID][j],rays[j],intersect);
+              scatter1(octants[octantID][j],rays[j]);
             
             rays_in_octant[octantID] = 0;
           }
@@ -422,10 +428,79 @@ namespace embree
             scene->occludedN((RTCRay**)rays_ptr,rays_in_octant[i],context);        
 
           for (size_t j=0;j<rays_in_octant[i];j++)
-            rayN.scatterByOffset(octants[i][j],rays[j],intersect);
+            scatter1(octants[i][j],rays[j]);
         }
     }
 
-    RayStreamFilterFuncs rayStreamFilters(RayStream::filterAOS,RayStream::filterAOP,RayStream::filterSOA,RayStream::filterSOP);
+    void RayStream::filterSOP(Scene *scene, const RTCRayNp& _rayN, const size_t N, IntersectContext* context, const bool intersect)
+    {
+      RayPN& rayN = *(RayPN*)&_rayN;
+      traceSOP(scene,rayN,N,context,intersect,
+               [&] (const vboolx& valid, const vboolx& active, const size_t offset, const RayK<VSIZEX>& ray) { rayN.scatter<VSIZEX>(active,offset,ray,intersect); },
+               [&] (const size_t offset, const Ray& ray) { rayN.scatterByOffset(offset,ray,intersect); },
+               [&] (const size_t offset) {});
+    }
+
+    /*! returns a copy of the stream that only references the ray data components */
+    static __forceinline RayPN rayDataOnly(const RTCRayNp& rays)
+    {
+      RayPN rayN = *(RayPN*)&rays;
+      rayN.Ngx = rayN.Ngy = rayN.Ngz = nullptr;
+      rayN.u = rayN.v = nullptr;
+      rayN.geomID = rayN.primID = rayN.instID = nullptr;
+      return rayN;
+    }
+
+    void RayStream::filterSOPMask(Scene *scene, const RTCRayNp& _rayN, const size_t N, IntersectContext* context, unsigned* occluded)
+    {
+      RayPN rayN = rayDataOnly(_rayN);
+
+      /* the hit data of the ray stream is never touched, only the packed occlusion bits get written */
+      for (size_t i=0; i<(N+31)/32; i++) occluded[i] = 0;
+
+      traceSOP(scene,rayN,N,context,false,
+               [&] (const vboolx& valid, const vboolx& active, const size_t offset, const RayK<VSIZEX>& ray) {
+                 const size_t i = offset/sizeof(float);
+                 occluded[i/32] |= (unsigned) movemask(active & (ray.geomID == 0)) << (i%32);
+               },
+               [&] (const size_t offset, const Ray& ray) {
+                 const size_t i = offset/sizeof(float);
+                 if (ray.geomID == 0) occluded[i/32] |= 1u << (i%32);
+               },
+               [&] (const size_t offset) {});
+    }
+
+    void RayStream::filterSOPCompact(Scene *scene, const RTCRayNp& _rayN, const size_t N, IntersectContext* context, RTCCompactHit* hits)
+    {
+      RayPN rayN = rayDataOnly(_rayN);
+      traceSOP(scene,rayN,N,context,true,
+               [&] (const vboolx& valid, const vboolx& active, const size_t offset, const RayK<VSIZEX>& ray) {
+                 const vboolx hit = active & (ray.geomID != RTC_INVALID_GEOMETRY_ID);
+                 const size_t i = offset/sizeof(float);
+                 for (size_t bits=movemask(valid); bits!=0; ) 
+                 {
+                   const size_t k = __bscf(bits);
+                   RTCCompactHit& h = hits[i+k];
+                   h.t      = ray.tfar[k];
+                   h.primID = hit[k] ? ray.primID[k] : RTC_INVALID_GEOMETRY_ID;
+                   h.geomID = hit[k] ? ray.geomID[k] : RTC_INVALID_GEOMETRY_ID;
+                 }
+               },
+               [&] (const size_t offset, const Ray& ray) {
+                 RTCCompactHit& h = hits[offset/sizeof(float)];
+                 const bool hit = ray.geomID != RTC_INVALID_GEOMETRY_ID;
+                 h.t      = ray.tfar;
+                 h.primID = hit ? ray.primID : RTC_INVALID_GEOMETRY_ID;
+                 h.geomID = ray.geomID;
+               },
+               [&] (const size_t offset) {
+                 RTCCompactHit& h = hits[offset/sizeof(float)];
+                 h.t      = *(float*)((char*)rayN.tfar + offset);
+                 h.primID = RTC_INVALID_GEOMETRY_ID;
+                 h.geomID = RTC_INVALID_GEOMETRY_ID;
+               });
+    }
+
+    RayStreamFilterFuncs rayStreamFilters(RayStream::filterAOS,RayStream::filterAOP,RayStream::filterSOA,RayStream::filterSOP,RayStream::filterSOPMask,RayStream::filterSOPCompact);
   };
 };
@@ -32,6 +32,8 @@ namespace embree
       static void filterAOP(Scene* scene, RTCRay**   rays, const size_t N, IntersectContext* context, const bool intersect);
       static void filterSOA(Scene* scene, char*      rays, const size_t N, const size_t streams, const size_t stream_offset, IntersectContext* context, const bool intersect);
       static void filterSOP(Scene* scene, const RTCRayNp& rays, const size_t N, IntersectContext* context, const bool intersect);
+      static void filterSOPMask(Scene* scene, const RTCRayNp& rays, const size_t N, IntersectContext* context, unsigned* occluded);
+      static void filterSOPCompact(Scene* scene, const RTCRayNp& rays, const size_t N, IntersectContext* context, RTCCompactHit* hits);
     };
   }
 };
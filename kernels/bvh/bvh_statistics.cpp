@@ -26,8 +26,10 @@ namespace embree
     {
       NodeRef* roots = (NodeRef*)(size_t)bvh->root;
       for (size_t i=0; i<bvh->numTimeSteps-1; i++) {
-        const BBox1f t0t1(float(i+0)/float(bvh->numTimeSteps-1),
-                        float(i+1)/float(bvh->numTimeSteps-1));
+        const BBox1f t0t1 = bvh->timeSteps.size()
+          ? BBox1f(bvh->timeSteps[i+0],bvh->timeSteps[i+1])
+          : BBox1f(float(i+0)/float(bvh->numTimeSteps-1),
+                   float(i+1)/float(bvh->numTimeSteps-1));
         stat = stat + statistics(roots[i],A,t0t1);
       }
     }
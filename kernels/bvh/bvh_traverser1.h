@@ -112,7 +112,7 @@ namespace embree
         cur = node->child(r); 
         cur.prefetch(types);
 
-        /* simpler in sequence traversal order */
+        /* simpler in sequence traversal order, continues with the last (largest) child */
         assert(cur != BVH::emptyNode);
         if (likely(mask == 0)) return;
         assert(stackPtr < stackEnd);
@@ -229,7 +229,7 @@ namespace embree
         cur = node->child(r);
         cur.prefetch(types);
 
-        /* simpler in sequence traversal order */
+        /* simpler in sequence traversal order, continues with the last (largest) child */
         assert(cur != BVH::emptyNode);
         if (likely(mask == 0)) return;
         assert(stackPtr < stackEnd);
@@ -451,22 +451,27 @@ namespace embree
   typedef void (*filterAOP_func)(Scene *scene, RTCRay** _rayN, const size_t N, IntersectContext* context, const bool intersect);
   typedef void (*filterSOA_func)(Scene *scene, char* rayN, const size_t N, const size_t streams, const size_t stream_offset, IntersectContext* context, const bool intersect);
   typedef void (*filterSOP_func)(Scene *scene, const RTCRayNp& rayN, const size_t N, IntersectContext* context, const bool intersect);
+  typedef void (*filterSOPMask_func)(Scene *scene, const RTCRayNp& rayN, const size_t N, IntersectContext* context, unsigned* occluded);
+  typedef void (*filterSOPCompact_func)(Scene *scene, const RTCRayNp& rayN, const size_t N, IntersectContext* context, RTCCompactHit* hits);
 
   struct RayStreamFilterFuncs
   {
     __forceinline RayStreamFilterFuncs()
-      : filterAOS(nullptr), filterSOA(nullptr), filterSOP(nullptr) {}
+      : filterAOS(nullptr), filterAOP(nullptr), filterSOA(nullptr), filterSOP(nullptr), filterSOPMask(nullptr), filterSOPCompact(nullptr) {}
     
     __forceinline RayStreamFilterFuncs(void (*ptr) ()) 
-      : filterAOS((filterAOS_func) ptr), filterSOA((filterSOA_func) ptr), filterSOP((filterSOP_func) ptr) {}
+      : filterAOS((filterAOS_func) ptr), filterAOP((filterAOP_func) ptr), filterSOA((filterSOA_func) ptr), filterSOP((filterSOP_func) ptr), 
+      filterSOPMask((filterSOPMask_func) ptr), filterSOPCompact((filterSOPCompact_func) ptr) {}
 
-    __forceinline RayStreamFilterFuncs(filterAOS_func aos, filterAOP_func aop, filterSOA_func soa, filterSOP_func sop) 
-      : filterAOS(aos), filterAOP(aop), filterSOA(soa), filterSOP(sop) {}
+    __forceinline RayStreamFilterFuncs(filterAOS_func aos, filterAOP_func aop, filterSOA_func soa, filterSOP_func sop, filterSOPMask_func sop_mask, filterSOPCompact_func sop_compact) 
+      : filterAOS(aos), filterAOP(aop), filterSOA(soa), filterSOP(sop), filterSOPMask(sop_mask), filterSOPCompact(sop_compact) {}
 
   public:
     filterAOS_func filterAOS;
     filterAOP_func filterAOP;
     filterSOA_func filterSOA;
     filterSOP_func filterSOP;
+    filterSOPMask_func filterSOPMask;
+    filterSOPCompact_func filterSOPCompact;
   }; 
 }
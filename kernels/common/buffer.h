@@ -192,6 +192,20 @@ namespace embree
       ptr = nullptr; this->ptr_ofs = nullptr;
     }
     
+    /*! shrinks the buffer to its first num_in elements, only supported for buffers we own */
+    void shrink(size_t num_in)
+    {
+      assert(!shared && num_in <= this->num);
+      if (!ptr || num_in == this->num) return;
+      char* ptr_old = ptr;
+      const size_t bytes_old = this->bytes();
+      this->num = num_in;
+      ptr = this->ptr_ofs = (char*) alignedMalloc(this->bytes());
+      memcpy(ptr,ptr_old,this->bytes());
+      alignedFree(ptr_old);
+      if (device) device->memoryMonitor(-ssize_t(bytes_old-this->bytes()),true);
+    }
+    
     /*! maps the buffer */
     void* map(std::atomic<size_t>& cntr)
     {
@@ -225,6 +239,11 @@ namespace embree
       mapped = false;
     }
     
+    /*! checks if the buffer is shared with the application */
+    __forceinline bool isShared() const {
+      return shared; 
+    }
+    
     /*! checks if the buffer is mapped */
     __forceinline bool isMapped() const {
       return mapped; 
@@ -23,6 +23,7 @@
 #include "scene_subdiv_mesh.h"
 
 #include "../subdiv/tessellation_cache.h"
+#include "../subdiv/tessellation_cache_file.h"
 
 #include "acceln.h"
 #include "geometry.h"
@@ -45,6 +46,10 @@
 #  include "../common/tasking/taskschedulerppl.h"
 #endif
 
+#if defined(TASKING_EXTERNAL)
+#  include "../common/tasking/taskschedulerexternal.h"
+#endif
+
 namespace embree
 {
   /*! some global variables that can be set via rtcSetParameter1i for debugging purposes */
@@ -77,6 +82,10 @@ namespace embree
     /*! set tessellation cache size */
     setCacheSize( State::tessellation_cache_size );
 
+    /*! open persistent tessellation cache */
+    if (State::tessellation_cache_file != "")
+      tessellation_cache_file.reset(new TessellationCacheFile(State::tessellation_cache_file,State::tessellation_cache_file_size));
+
     /*! enable some floating point exceptions to catch bugs */
     if (State::float_exceptions)
     {
@@ -116,6 +125,8 @@ namespace embree
 
   Device::~Device ()
   {
+    if (tessellation_cache_file && State::verbosity(1))
+      tessellation_cache_file->print();
     setCacheSize(0);
     exitTaskingSystem();
   }
@@ -179,7 +190,7 @@ namespace embree
     const bool hasDAZ = _mm_getcsr() & _MM_DENORMALS_ZERO_ON;
     std::cout << "   MXCSR    : " << "FTZ=" << hasFTZ << ", DAZ=" << hasDAZ << std::endl;
     std::cout << "  Config" << std::endl;
-    std::cout << "    Threads : " << (numThreads ? toString(numThreads) : std::string("default")) << std::endl;
+    std::cout << "    Threads : " << (numThreads ? toString(numThreads) : std::string("default")) << (isolated_threads ? " (isolated)" : "") << std::endl;
     std::cout << "    ISA     : " << stringOfCPUFeatures(enabled_cpu_features) << std::endl;
     std::cout << "    Targets : " << supportedTargetList(enabled_cpu_features) << " (supported)" << std::endl;
     std::cout << "              " << getEnabledTargets() << " (compile time enabled)" << std::endl;
@@ -194,6 +205,9 @@ namespace embree
 #endif
 #if defined(TASKING_PPL)
 	std::cout << "PPL ";
+#endif
+#if defined(TASKING_EXTERNAL)
+    std::cout << "external_job_system ";
 #endif
     std::cout << std::endl;
 
@@ -325,7 +339,11 @@ namespace embree
   void Device::initTaskingSystem(size_t numThreads) 
   {
     Lock<MutexSys> lock(g_mutex);
-    if (numThreads == 0) 
+
+    /* isolated devices do not contribute to the size of the shared thread pool */
+    if (State::isolated_threads)
+      g_num_threads_map[this] = 1;
+    else if (numThreads == 0) 
       g_num_threads_map[this] = std::numeric_limits<size_t>::max();
     else 
       g_num_threads_map[this] = numThreads;
@@ -333,8 +351,20 @@ namespace embree
     /* create task scheduler */
     size_t maxNumThreads = getMaxNumThreads();
     TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads);
+
+    /* create private thread pool for isolated devices */
+#if defined(TASKING_INTERNAL)
+    if (State::isolated_threads) {
+      threadPool.reset(new TaskScheduler::ThreadPool(State::set_affinity,State::affinity_offset));
+      threadPool->setNumThreads(numThreads,State::start_threads);
+    }
+#endif
+
 #if USE_TASK_ARENA
-    arena.reset(new tbb::task_arena(int(maxNumThreads)));
+    if (State::isolated_threads) 
+      arena.reset(new tbb::task_arena(numThreads ? int(numThreads) : int(tbb::task_arena::automatic)));
+    else
+      arena.reset(new tbb::task_arena(int(maxNumThreads)));
 #endif
   }
 
@@ -343,6 +373,10 @@ namespace embree
     Lock<MutexSys> lock(g_mutex);
     g_num_threads_map.erase(this);
 
+#if defined(TASKING_INTERNAL)
+    threadPool.reset();
+#endif
+
     /* terminate tasking system */
     if (g_num_threads_map.size() == 0) {
       TaskScheduler::destroy();
@@ -357,6 +391,16 @@ namespace embree
 #endif
   }
 
+  void Device::setJobSystem(RTCRunJobsFunc runJobs, RTCThreadIndexFunc threadIndex, size_t threadCount, void* userPtr)
+  {
+#if defined(TASKING_EXTERNAL)
+    Lock<MutexSys> lock(g_mutex);
+    TaskScheduler::setJobSystem(runJobs,threadIndex,threadCount,userPtr);
+#else
+    throw_RTCError(RTC_INVALID_OPERATION,"external job system requires the EXTERNAL tasking system");
+#endif
+  }
+
   void Device::setParameter1i(const RTCParameter parm, ssize_t val)
   {
     /* hidden internal parameters */
@@ -466,6 +510,10 @@ namespace embree
     case RTC_CONFIG_TASKING_SYSTEM: return 1;
 #endif
 
+#if defined(TASKING_EXTERNAL)
+    case RTC_CONFIG_TASKING_SYSTEM: return 2;
+#endif
+
 #if defined(EMBREE_GEOMETRY_TRIANGLES)
     case RTC_CONFIG_TRIANGLE_GEOMETRY: return 1;
 #else
@@ -25,6 +25,7 @@ namespace embree
   class BVH4Factory;
   class BVH8Factory;
   class InstanceFactory;
+  class TessellationCacheFile;
 
   class Device : public State, public MemoryMonitorInterface
   {
@@ -68,6 +69,9 @@ namespace embree
     /*! returns some configuration */
     ssize_t getParameter1i(const RTCParameter parm);
 
+    /*! forwards all parallel work to an external job system */
+    void setJobSystem(RTCRunJobsFunc runJobs, RTCThreadIndexFunc threadIndex, size_t threadCount, void* userPtr);
+
   private:
 
     /*! initializes the tasking system */
@@ -91,10 +95,18 @@ namespace embree
 #if defined(__TARGET_AVX__)
     std::unique_ptr<BVH8Factory> bvh8_factory;
 #endif
+
+    /*! persistent tessellation cache, only present if a tessellation cache file is configured */
+    std::unique_ptr<TessellationCacheFile> tessellation_cache_file;
     
 #if USE_TASK_ARENA
     std::unique_ptr<tbb::task_arena> arena;
 #endif
+
+#if defined(TASKING_INTERNAL)
+    /*! private thread pool of this device, only present in isolated_threads mode */
+    std::unique_ptr<TaskScheduler::ThreadPool> threadPool;
+#endif
     
     /* ray streams filter */
     RayStreamFilterFuncs rayStreamFilters;
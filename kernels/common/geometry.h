@@ -100,6 +100,9 @@ namespace embree
     /*! Free buffers that are unused */
     virtual void immutable () {}
 
+    /*! Welds identical vertices, returns the number of bytes saved */
+    virtual size_t weldVertices () { return 0; }
+
     /*! Verify the geometry */
     virtual bool verify () { return true; }
 
@@ -114,6 +117,16 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! sets cameras to calculate the tessellation levels from */
+    virtual void setTessellationCameras(const RTCTessellationCamera* cameras, size_t numCameras, float edgeLength) {
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! sets the distance beyond which curves get intersected as flat ribbons */
+    virtual void setRibbonDistance(float distance) {
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Set user data pointer. */
     virtual void setUserData (void* ptr);
       
@@ -171,6 +184,11 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Set batched displacement function. */
+    virtual void setDisplacementBatchFunction (RTCDisplacementBatchFunc func, RTCBounds* bounds) {
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Set intersection filter function for single rays. */
     virtual void setIntersectionFilterFunction (RTCFilterFunc filter, bool ispc = false);
     
@@ -209,6 +227,11 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Sets double precision transformation of the instance */
+    virtual void setTransform(const AffineSpace3d& transform, size_t timeStep) {
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! for user geometries only */
   public:
 
@@ -424,6 +447,69 @@ namespace embree
       return true;
     }
 
+    /*! calculates the linear bounds of a primitive for an arbitrary time range, if it's valid */
+    template<typename BoundsFunc>
+    __forceinline static bool linearBounds(const BoundsFunc& bounds, const BBox1f& time_range, float numTimeSegments, LBBox3fa& lbbox)
+    {
+      const float lower = time_range.lower*numTimeSegments;
+      const float upper = time_range.upper*numTimeSegments;
+      const float ilowerf = clamp(floor(lower), 0.0f, numTimeSegments-1.0f);
+      const float iupperf = max(min(ceil(upper), numTimeSegments), ilowerf+1.0f);
+      const int ilower = int(ilowerf);
+      const int iupper = int(iupperf);
+
+      BBox3fa blower0; if (unlikely(!bounds(ilower,blower0))) return false;
+      BBox3fa bupper1; if (unlikely(!bounds(iupper,bupper1))) return false;
+
+      /* the time range lies inside a single time segment of the primitive */
+      if (iupper-ilower == 1) {
+        lbbox = LBBox3fa(lerp(blower0, bupper1, lower-ilowerf), lerp(blower0, bupper1, upper-ilowerf));
+        return true;
+      }
+
+      /* otherwise we have to enlarge the bounds to include all time steps inside the time range */
+      BBox3fa blower1; if (unlikely(!bounds(ilower+1,blower1))) return false;
+      BBox3fa bupper0; if (unlikely(!bounds(iupper-1,bupper0))) return false;
+      BBox3fa b0 = lerp(blower0, blower1, lower-ilowerf);
+      BBox3fa b1 = lerp(bupper0, bupper1, upper-(iupperf-1.0f));
+
+      for (int i=ilower+1; i<iupper; i++)
+      {
+        BBox3fa bi; if (unlikely(!bounds(i,bi))) return false;
+        const float f = (float(i)/numTimeSegments - time_range.lower) / time_range.size();
+        const BBox3fa bt = lerp(b0, b1, f);
+        const Vec3fa dlower = min(bi.lower-bt.lower, Vec3fa(zero));
+        const Vec3fa dupper = max(bi.upper-bt.upper, Vec3fa(zero));
+        b0.lower += dlower; b1.lower += dlower;
+        b0.upper += dupper; b1.upper += dupper;
+      }
+
+      lbbox = LBBox3fa(b0, b1);
+      return true;
+    }
+
+    /*! calculates the linear bounds of a primitive for an arbitrary time range */
+    template<typename BoundsFunc>
+    __forceinline static LBBox3fa linearBounds(const BoundsFunc& bounds, const BBox1f& time_range, float numTimeSegments)
+    {
+      LBBox3fa lbbox;
+      linearBounds([&] (size_t itime, BBox3fa& bbox) -> bool { bbox = bounds(itime); return true; },
+                   time_range, numTimeSegments, lbbox);
+      return lbbox;
+    }
+
+    /*! calculates the build bounds of a primitive for an arbitrary time range, if it's valid */
+    template<typename BoundsFunc>
+    __forceinline static bool buildBounds(const BoundsFunc& bounds, const BBox1f& time_range, float numTimeSegments, BBox3fa& bbox)
+    {
+      LBBox3fa lbbox;
+      if (!linearBounds(bounds, time_range, numTimeSegments, lbbox))
+        return false;
+
+      bbox = 0.5f * (lbbox.bounds0 + lbbox.bounds1);
+      return true;
+    }
+
     /*! checks if a primitive is valid at the itimeGlobal'th time segment */
     template<typename ValidFunc>
     __forceinline static bool validLinearBounds(const ValidFunc& valid, size_t itimeGlobal, size_t numTimeStepsGlobal, size_t numTimeSteps)
@@ -176,6 +176,16 @@ namespace embree
     RTCORE_CATCH_END(device);
   }
 
+  RTCORE_API void rtcDeviceSetJobSystem(RTCDevice hdevice, RTCRunJobsFunc runJobs, RTCThreadIndexFunc threadIndex, size_t threadCount, void* userPtr) 
+  {
+    Device* device = (Device*) hdevice;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcDeviceSetJobSystem);
+    RTCORE_VERIFY_HANDLE(hdevice);
+    device->setJobSystem(runJobs,threadIndex,threadCount,userPtr);
+    RTCORE_CATCH_END(device);
+  }
+
   RTCORE_API void rtcDebug() 
   {
     RTCORE_CATCH_BEGIN;
@@ -527,6 +537,37 @@ namespace embree
 #endif
     RTCORE_CATCH_END(scene->device);
   }
+
+  RTCORE_API void rtcIntersectNpCompact (RTCScene hscene, const RTCIntersectContext* user_context, const RTCRayNp& rays, RTCCompactHit* hits, const size_t N) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcIntersectNpCompact);
+
+#if defined (EMBREE_RAY_PACKETS)
+#if defined(DEBUG)
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)rays.orgx   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.orgx not aligned to 4 bytes");   
+    if (((size_t)rays.orgy   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.orgy not aligned to 4 bytes");   
+    if (((size_t)rays.orgz   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.orgz not aligned to 4 bytes");   
+    if (((size_t)rays.dirx   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.dirx not aligned to 4 bytes");   
+    if (((size_t)rays.diry   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.diry not aligned to 4 bytes");   
+    if (((size_t)rays.dirz   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.dirz not aligned to 4 bytes");   
+    if (((size_t)rays.tnear  ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.tnear not aligned to 4 bytes");   
+    if (((size_t)rays.tfar   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.tfar not aligned to 4 bytes");   
+    if (((size_t)rays.time   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.time not aligned to 4 bytes");   
+    if (((size_t)rays.mask   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.mask not aligned to 4 bytes");   
+    if (((size_t)hits        ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "hits not aligned to 4 bytes");   
+#endif
+    STAT3(normal.travs,N,N,N);
+    IntersectContext context(scene,user_context);
+    scene->device->rayStreamFilters.filterSOPCompact(scene,rays,N,&context,hits);
+#else
+    throw_RTCError(RTC_INVALID_OPERATION,"rtcIntersectNpCompact not supported");
+#endif
+    RTCORE_CATCH_END(scene->device);
+  }
   
   RTCORE_API void rtcOccluded (RTCScene hscene, RTCRay& ray) 
   {
@@ -751,6 +792,37 @@ namespace embree
 #endif
     RTCORE_CATCH_END(scene->device);
   }
+
+  RTCORE_API void rtcOccludedNpMask(RTCScene hscene, const RTCIntersectContext* user_context, const RTCRayNp& rays, unsigned* occluded, const size_t N) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcOccludedNpMask);
+
+#if defined (EMBREE_RAY_PACKETS)
+#if defined(DEBUG)
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)rays.orgx   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.orgx not aligned to 4 bytes");   
+    if (((size_t)rays.orgy   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.orgy not aligned to 4 bytes");   
+    if (((size_t)rays.orgz   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.orgz not aligned to 4 bytes");   
+    if (((size_t)rays.dirx   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.dirx not aligned to 4 bytes");   
+    if (((size_t)rays.diry   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.diry not aligned to 4 bytes");   
+    if (((size_t)rays.dirz   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.dirz not aligned to 4 bytes");   
+    if (((size_t)rays.tnear  ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.tnear not aligned to 4 bytes");   
+    if (((size_t)rays.tfar   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.tfar not aligned to 4 bytes");   
+    if (((size_t)rays.time   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.time not aligned to 4 bytes");   
+    if (((size_t)rays.mask   ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.mask not aligned to 4 bytes");   
+    if (((size_t)occluded    ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "occluded not aligned to 4 bytes");   
+#endif
+    STAT3(shadow.travs,N,N,N);
+    IntersectContext context(scene,user_context);
+    scene->device->rayStreamFilters.filterSOPMask(scene,rays,N,&context,occluded);
+#else
+    throw_RTCError(RTC_INVALID_OPERATION,"rtcOccludedNpMask not supported");
+#endif
+    RTCORE_CATCH_END(scene->device);
+  }
   
   RTCORE_API void rtcDeleteScene (RTCScene hscene) 
   {
@@ -803,30 +875,31 @@ namespace embree
     return -1;
     }*/
 
-  AffineSpace3fa convertTransform(RTCMatrixType layout, const float* xfm)
+  template<typename Vec3, typename T>
+  AffineSpaceT<LinearSpace3<Vec3>> convertTransform(RTCMatrixType layout, const T* xfm)
   {
-    AffineSpace3fa transform = one;
+    AffineSpaceT<LinearSpace3<Vec3>> transform = one;
     switch (layout) 
     {
     case RTC_MATRIX_ROW_MAJOR:
-      transform = AffineSpace3fa(Vec3fa(xfm[ 0],xfm[ 4],xfm[ 8]),
-                                 Vec3fa(xfm[ 1],xfm[ 5],xfm[ 9]),
-                                 Vec3fa(xfm[ 2],xfm[ 6],xfm[10]),
-                                 Vec3fa(xfm[ 3],xfm[ 7],xfm[11]));
+      transform = AffineSpaceT<LinearSpace3<Vec3>>(Vec3(xfm[ 0],xfm[ 4],xfm[ 8]),
+                                                   Vec3(xfm[ 1],xfm[ 5],xfm[ 9]),
+                                                   Vec3(xfm[ 2],xfm[ 6],xfm[10]),
+                                                   Vec3(xfm[ 3],xfm[ 7],xfm[11]));
       break;
 
     case RTC_MATRIX_COLUMN_MAJOR:
-      transform = AffineSpace3fa(Vec3fa(xfm[ 0],xfm[ 1],xfm[ 2]),
-                                 Vec3fa(xfm[ 3],xfm[ 4],xfm[ 5]),
-                                 Vec3fa(xfm[ 6],xfm[ 7],xfm[ 8]),
-                                 Vec3fa(xfm[ 9],xfm[10],xfm[11]));
+      transform = AffineSpaceT<LinearSpace3<Vec3>>(Vec3(xfm[ 0],xfm[ 1],xfm[ 2]),
+                                                   Vec3(xfm[ 3],xfm[ 4],xfm[ 5]),
+                                                   Vec3(xfm[ 6],xfm[ 7],xfm[ 8]),
+                                                   Vec3(xfm[ 9],xfm[10],xfm[11]));
       break;
 
     case RTC_MATRIX_COLUMN_MAJOR_ALIGNED16:
-      transform = AffineSpace3fa(Vec3fa(xfm[ 0],xfm[ 1],xfm[ 2]),
-                                 Vec3fa(xfm[ 4],xfm[ 5],xfm[ 6]),
-                                 Vec3fa(xfm[ 8],xfm[ 9],xfm[10]),
-                                 Vec3fa(xfm[12],xfm[13],xfm[14]));
+      transform = AffineSpaceT<LinearSpace3<Vec3>>(Vec3(xfm[ 0],xfm[ 1],xfm[ 2]),
+                                                   Vec3(xfm[ 4],xfm[ 5],xfm[ 6]),
+                                                   Vec3(xfm[ 8],xfm[ 9],xfm[10]),
+                                                   Vec3(xfm[12],xfm[13],xfm[14]));
       break;
 
     default: 
@@ -844,7 +917,7 @@ namespace embree
     RTCORE_VERIFY_HANDLE(hscene);
     RTCORE_VERIFY_GEOMID(geomID);
     RTCORE_VERIFY_HANDLE(xfm);
-    const AffineSpace3fa transform = convertTransform(layout,xfm);
+    const AffineSpace3fa transform = convertTransform<Vec3fa>(layout,xfm);
     ((Scene*) scene)->get_locked(geomID)->setTransform(transform,0);
     RTCORE_CATCH_END(scene->device);
   }
@@ -857,7 +930,20 @@ namespace embree
     RTCORE_VERIFY_HANDLE(hscene);
     RTCORE_VERIFY_GEOMID(geomID);
     RTCORE_VERIFY_HANDLE(xfm);
-    const AffineSpace3fa transform = convertTransform(layout,xfm);
+    const AffineSpace3fa transform = convertTransform<Vec3fa>(layout,xfm);
+    ((Scene*) scene)->get_locked(geomID)->setTransform(transform,timeStep);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcSetTransformd (RTCScene hscene, unsigned geomID, RTCMatrixType layout, const double* xfm, size_t timeStep) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetTransformd);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    RTCORE_VERIFY_HANDLE(xfm);
+    const AffineSpace3d transform = convertTransform<Vec3d>(layout,xfm);
     ((Scene*) scene)->get_locked(geomID)->setTransform(transform,timeStep);
     RTCORE_CATCH_END(scene->device);
   }
@@ -1084,6 +1170,28 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetCurveRibbonDistance (RTCScene hscene, unsigned geomID, float distance)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetCurveRibbonDistance);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setRibbonDistance(distance);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcSetTessellationCameras (RTCScene hscene, unsigned geomID, const RTCTessellationCamera* cameras, size_t numCameras, float edgeLength)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetTessellationCameras);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setTessellationCameras(cameras,numCameras,edgeLength);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcSetUserData (RTCScene hscene, unsigned geomID, void* ptr) 
   {
     Scene* scene = (Scene*) hscene;
@@ -1162,6 +1270,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetDisplacementBatchFunction (RTCScene hscene, unsigned geomID, RTCDisplacementBatchFunc func, RTCBounds* bounds)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetDisplacementBatchFunction);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setDisplacementBatchFunction(func,bounds);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcSetIntersectFunction (RTCScene hscene, unsigned geomID, RTCIntersectFunc intersect) 
   {
     Scene* scene = (Scene*) hscene;
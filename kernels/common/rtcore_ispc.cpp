@@ -155,6 +155,10 @@ namespace embree
   extern "C" void ispcIntersectNp (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, const  size_t N) {
     rtcIntersectNp(scene,context,rays,N);
   }
+
+  extern "C" void ispcIntersectNpCompact (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, RTCCompactHit* hits, const size_t N) {
+    rtcIntersectNpCompact(scene,context,rays,hits,N);
+  }
   
   extern "C" void ispcOccluded1 (RTCScene scene, RTCRay& ray) {
     rtcOccluded(scene,ray);
@@ -187,6 +191,10 @@ namespace embree
   extern "C" void ispcOccludedNp (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, const  size_t N) {
     rtcOccludedNp(scene,context,rays,N);
   }
+
+  extern "C" void ispcOccludedNpMask (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, unsigned* occluded, const size_t N) {
+    rtcOccludedNpMask(scene,context,rays,occluded,N);
+  }
   
   extern "C" void ispcDeleteScene (RTCScene scene) {
     rtcDeleteScene(scene);
@@ -211,6 +219,10 @@ namespace embree
   extern "C" void ispcSetTransform2 (RTCScene scene, unsigned geomID, RTCMatrixType layout, const float* xfm, size_t timeStep) {
     return rtcSetTransform2(scene,geomID,layout,xfm,timeStep);
   }
+
+  extern "C" void ispcSetTransformd (RTCScene scene, unsigned geomID, RTCMatrixType layout, const double* xfm, size_t timeStep) {
+    return rtcSetTransformd(scene,geomID,layout,xfm,timeStep);
+  }
   
   extern "C" unsigned ispcNewUserGeometry (RTCScene scene, size_t numItems) {
     return rtcNewUserGeometry(scene,numItems);
@@ -293,6 +305,14 @@ namespace embree
   extern "C" void ispcSetTessellationRate (RTCScene hscene, unsigned geomID, float tessellationRate) {
     rtcSetTessellationRate(hscene,geomID,tessellationRate);
   }
+
+  extern "C" void ispcSetCurveRibbonDistance (RTCScene hscene, unsigned geomID, float distance) {
+    rtcSetCurveRibbonDistance(hscene,geomID,distance);
+  }
+
+  extern "C" void ispcSetTessellationCameras (RTCScene hscene, unsigned geomID, const RTCTessellationCamera* cameras, size_t numCameras, float edgeLength) {
+    rtcSetTessellationCameras(hscene,geomID,cameras,numCameras,edgeLength);
+  }
     
   extern "C" void ispcSetUserData (RTCScene hscene, unsigned geomID, void* ptr) 
   {
@@ -592,6 +612,17 @@ namespace embree
     ((Scene*)scene)->get_locked(geomID)->setDisplacementFunction2((RTCDisplacementFunc2)func,bounds);
     RTCORE_CATCH_END(scene->device);
   }
+
+  extern "C" void ispcSetDisplacementBatchFunction (RTCScene hscene, unsigned int geomID, void* func, RTCBounds* bounds)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetDisplacementBatchFunction);
+    RTCORE_VERIFY_HANDLE(scene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    ((Scene*)scene)->get_locked(geomID)->setDisplacementBatchFunction((RTCDisplacementBatchFunc)func,bounds);
+    RTCORE_CATCH_END(scene->device);
+  }
   
   extern "C" void ispcInterpolateN(RTCScene scene, unsigned int geomID, 
                                    const void* valid, const unsigned int* primIDs, const float* u, const float* v, size_t numUVs, 
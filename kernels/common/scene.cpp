@@ -174,6 +174,7 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4")       accels.add(device->bvh4_factory->BVH4Triangle4 (this));
     else if (device->tri_accel == "bvh4.triangle4v")      accels.add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels.add(device->bvh4_factory->BVH4Triangle4i(this));
+    else if (device->tri_accel == "bvh4.triangle4m")      accels.add(device->bvh4_factory->BVH4Triangle4m(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels.add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
 
 #if defined (__TARGET_AVX__)
@@ -337,8 +338,8 @@ namespace embree
         if (device->hasISA(AVX2)) // only enable on HSW machines, for SNB this codepath is slower
         {
           switch (mode) {
-          case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8OBBBezier1v(this)); break;
-          case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8OBBBezier1v(this)); break;
+          case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8OBBBezier4v(this)); break;
+          case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8OBBBezier4v(this)); break;
           case /*0b10*/ 2: accels.add(device->bvh8_factory->BVH8OBBBezier1i(this)); break;
           case /*0b11*/ 3: accels.add(device->bvh8_factory->BVH8OBBBezier1i(this)); break;
           }
@@ -347,8 +348,8 @@ namespace embree
 #endif
         {
           switch (mode) {
-          case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4OBBBezier1v(this)); break;
-          case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4OBBBezier1v(this)); break;
+          case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4OBBBezier4v(this)); break;
+          case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4OBBBezier4v(this)); break;
           case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4OBBBezier1i(this)); break;
           case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4OBBBezier1i(this)); break;
           }
@@ -368,9 +369,11 @@ namespace embree
     else if (device->hair_accel == "bvh4.bezier1i"    ) accels.add(device->bvh4_factory->BVH4Bezier1i(this));
     else if (device->hair_accel == "bvh4obb.bezier1v" ) accels.add(device->bvh4_factory->BVH4OBBBezier1v(this));
     else if (device->hair_accel == "bvh4obb.bezier1i" ) accels.add(device->bvh4_factory->BVH4OBBBezier1i(this));
+    else if (device->hair_accel == "bvh4obb.bezier4v" ) accels.add(device->bvh4_factory->BVH4OBBBezier4v(this));
 #if defined (__TARGET_AVX__)
     else if (device->hair_accel == "bvh8obb.bezier1v" ) accels.add(device->bvh8_factory->BVH8OBBBezier1v(this));
     else if (device->hair_accel == "bvh8obb.bezier1i" ) accels.add(device->bvh8_factory->BVH8OBBBezier1i(this));
+    else if (device->hair_accel == "bvh8obb.bezier4v" ) accels.add(device->bvh8_factory->BVH8OBBBezier4v(this));
 #endif
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown hair acceleration structure "+device->hair_accel);
 #endif
@@ -561,7 +564,13 @@ namespace embree
       return -1;
     }
     
-    Geometry* geom = new TriangleMesh(this,gflags,numTriangles,numVertices,numTimeSteps);
+    Geometry* geom = nullptr;
+#if defined(__TARGET_AVX__)
+    if (device->hasISA(AVX))
+      geom = new TriangleMeshAVX(this,gflags,numTriangles,numVertices,numTimeSteps);
+    else 
+#endif
+      geom = new TriangleMesh(this,gflags,numTriangles,numVertices,numTimeSteps);
     return geom->id;
   }
 
@@ -577,7 +586,13 @@ namespace embree
       return -1;
     }
     
-    Geometry* geom = new QuadMesh(this,gflags,numQuads,numVertices,numTimeSteps);
+    Geometry* geom = nullptr;
+#if defined(__TARGET_AVX__)
+    if (device->hasISA(AVX))
+      geom = new QuadMeshAVX(this,gflags,numQuads,numVertices,numTimeSteps);
+    else 
+#endif
+      geom = new QuadMesh(this,gflags,numQuads,numVertices,numTimeSteps);
     return geom->id;
   }
 
@@ -702,6 +717,16 @@ namespace embree
                   numIntersectionFiltersN+numIntersectionFilters16,
                   numIntersectionFiltersN);
   
+    /* weld identical vertices of static meshes before building */
+    if (isStatic() && device->vertex_welding)
+    {
+      size_t bytesSaved = 0;
+      for (size_t i=0; i<geometries.size(); i++)
+        if (geometries[i]) bytesSaved += geometries[i]->weldVertices();
+      if (device->verbosity(1))
+        std::cout << "vertex welding saved " << bytesSaved << " bytes" << std::endl;
+    }
+
     /* build all hierarchies of this scene */
     accels.build(0,0);
 
@@ -746,7 +771,7 @@ namespace embree
       scheduler = this->scheduler;
       if (scheduler == null) {
         buildLock.lock();
-        this->scheduler = scheduler = new TaskScheduler;
+        this->scheduler = scheduler = new TaskScheduler(device->threadPool.get());
       }
     }
 
@@ -880,6 +905,56 @@ namespace embree
   }
 #endif
 
+#if defined(TASKING_EXTERNAL)
+
+  void Scene::build (size_t threadIndex, size_t threadCount) 
+  {
+    /* in rtcCommitThread mode the first thread builds and all other threads wait for the build to finish */
+    if (threadCount != 0) {
+      group_barrier.wait(threadCount);
+      if (threadIndex > 0) {
+        group_barrier.wait(threadCount);
+        return;
+      }
+    }
+
+    /* concurrent commits wait for the build of the first thread */
+    Lock<MutexSys> lock(buildMutex);
+
+    if (!isModified()) {
+      if (threadCount) group_barrier.wait(threadCount);
+      return;
+    }
+
+    if (!ready()) {
+      if (threadCount) group_barrier.wait(threadCount);
+      throw_RTCError(RTC_INVALID_OPERATION,"not all buffers are unmapped");
+      return;
+    }
+
+    /* for best performance set FTZ and DAZ flags in the MXCSR control and status register */
+    unsigned int mxcsr = _mm_getcsr();
+    _mm_setcsr(mxcsr | /* FTZ */ (1<<15) | /* DAZ */ (1<<6));
+
+    /* all parallel work of the build gets forwarded to the job system */
+    try {
+      build_task();
+      _mm_setcsr(mxcsr);
+    } 
+    catch (...) {
+
+      /* reset MXCSR register again */
+      _mm_setcsr(mxcsr);
+      
+      accels.clear();
+      updateInterface();
+      if (threadCount) group_barrier.wait(threadCount);
+      throw;
+    }
+    if (threadCount) group_barrier.wait(threadCount);
+  }
+#endif
+
   void Scene::setProgressMonitorFunction(RTCProgressMonitorFunc func, void* ptr) 
   {
     static MutexSys mutex;
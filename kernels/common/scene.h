@@ -328,6 +328,8 @@ namespace embree
 #elif defined(TASKING_PPL)
 	concurrency::task_group* group;
 	BarrierActiveAutoReset group_barrier;
+#elif defined(TASKING_EXTERNAL)
+    BarrierActiveAutoReset group_barrier;
 #endif
     
   public:
@@ -21,7 +21,7 @@
 namespace embree
 {
   BezierCurves::BezierCurves (Scene* parent, SubType subtype, RTCGeometryFlags flags, size_t numPrimitives, size_t numVertices, size_t numTimeSteps) 
-    : Geometry(parent,BEZIER_CURVES,numPrimitives,numTimeSteps,flags), subtype(subtype), tessellationRate(4)
+    : Geometry(parent,BEZIER_CURVES,numPrimitives,numTimeSteps,flags), subtype(subtype), tessellationRate(4), ribbonDistance(pos_inf)
   {
     curves.init(parent->device,numPrimitives,sizeof(int));
     vertices.resize(numTimeSteps);
@@ -135,6 +135,17 @@ namespace embree
     tessellationRate = clamp((int)N,1,16);
   }
 
+  void BezierCurves::setRibbonDistance(float distance)
+  {
+    if (parent->isStatic() && parent->isBuild()) 
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+
+    if (!(distance >= 0.0f))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid ribbon distance");
+
+    ribbonDistance = distance;
+  }
+
   void BezierCurves::immutable () 
   {
     const bool freeIndices = !parent->needBezierIndices;
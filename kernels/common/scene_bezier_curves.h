@@ -48,6 +48,7 @@ namespace embree
     bool verify ();
     void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
     void setTessellationRate(float N);
+    void setRibbonDistance(float distance);
     // FIXME: implement interpolateN
 
   public:
@@ -62,6 +63,11 @@ namespace embree
       return vertices[0].size();
     }
     
+    /*! tests if a curve starting at p0 gets intersected as a flat ribbon by a ray starting at org */
+    __forceinline bool ribbon(const Vec3fa& org, const Vec3fa& p0) const {
+      return sqr_length(p0-org) >= ribbonDistance*ribbonDistance;
+    }
+    
     /*! returns the i'th curve */
     __forceinline const unsigned int& curve(size_t i) const {
       return curves[i];
@@ -265,5 +271,6 @@ namespace embree
     array_t<std::unique_ptr<APIBuffer<char>>,2> userbuffers; //!< user buffers
     SubType subtype;                                //!< hair or surface geometry
     int tessellationRate;                           //!< tessellation rate for bezier curve
+    float ribbonDistance;                           //!< distance from the ray origin beyond which curves are intersected as flat ribbons
   };
 }
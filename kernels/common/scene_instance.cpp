@@ -39,7 +39,7 @@ namespace embree
   }
 
   Instance::Instance (Scene* parent, Scene* object, size_t numTimeSteps) 
-    : AccelSet(parent,RTC_GEOMETRY_STATIC,1,numTimeSteps), object(object)
+    : AccelSet(parent,RTC_GEOMETRY_STATIC,1,numTimeSteps), object(object), precise(false)
   {
     world2local0 = one;
     for (size_t i=0; i<numTimeSteps; i++) local2world[i] = one;
@@ -63,6 +63,30 @@ namespace embree
 
     local2world[timeStep] = xfm;
     if (timeStep == 0) world2local0 = rcp(xfm);
+    if (precise) local2worldd[timeStep] = AffineSpace3d(xfm);
+    if (precise && timeStep == 0) world2local0d = rcp(local2worldd[0]);
+  }
+
+  void Instance::setTransform(const AffineSpace3d& xfm, size_t timeStep)
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    if (timeStep >= numTimeSteps)
+      throw_RTCError(RTC_INVALID_OPERATION,"invalid timestep");
+
+    /* switch to double precision transformations for all timesteps */
+    if (!precise) {
+      local2worldd.resize(numTimeSteps);
+      for (size_t i=0; i<numTimeSteps; i++) local2worldd[i] = AffineSpace3d(local2world[i]);
+      world2local0d = rcp(local2worldd[0]);
+      precise = true;
+    }
+
+    local2worldd[timeStep] = xfm;
+    if (timeStep == 0) world2local0d = rcp(xfm);
+    local2world[timeStep] = AffineSpace3fa(xfm);
+    if (timeStep == 0) world2local0 = AffineSpace3fa(world2local0d);
   }
 
   void Instance::setMask (unsigned mask) 
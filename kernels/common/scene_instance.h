@@ -44,6 +44,7 @@ namespace embree
     Instance (Scene* parent, Scene* object, size_t numTimeSteps); 
   public:
     virtual void setTransform(const AffineSpace3fa& local2world, size_t timeStep);
+    virtual void setTransform(const AffineSpace3d& local2world, size_t timeStep);
     virtual void setMask (unsigned mask);
     virtual void build(size_t threadIndex, size_t threadCount) {}
 
@@ -85,9 +86,40 @@ namespace embree
       return result;
 #endif
     }
+
+    __forceinline AffineSpace3d getWorld2Locald(float t) const 
+    {
+      float ftime;
+      const size_t itime = getTimeSegment(t, fnumTimeSegments, ftime);
+      return rcp(lerp(local2worldd[itime+0],local2worldd[itime+1],ftime));
+    }
+
+    /*! transforms a ray into the local space of the instance, rays
+     *  get transformed in double precision if the transformation got
+     *  specified in double precision */
+    __forceinline void xfmRay(const Vec3fa& org, const Vec3fa& dir, float time, Vec3fa& lorg, Vec3fa& ldir) const
+    {
+      if (unlikely(precise))
+      {
+        const AffineSpace3d world2local = 
+          likely(numTimeSteps == 1) ? world2local0d : getWorld2Locald(time);
+        lorg = Vec3fa(Vec3f(xfmPoint (world2local,Vec3d(org))));
+        ldir = Vec3fa(Vec3f(xfmVector(world2local,Vec3d(dir))));
+      }
+      else
+      {
+        const AffineSpace3fa world2local = 
+          likely(numTimeSteps == 1) ? getWorld2Local() : getWorld2Local(time);
+        lorg = xfmPoint (world2local,org);
+        ldir = xfmVector(world2local,dir);
+      }
+    }
     
   public:
     Scene* object;                 //!< pointer to instanced acceleration structure
+    bool precise;                  //!< true if the transformations got specified in double precision
+    AffineSpace3d world2local0d;   //!< double precision transformation from world space to local space for timestep 0
+    std::vector<AffineSpace3d> local2worldd; //!< double precision transformation from local space to world space for each timestep
     AffineSpace3fa world2local0;   //!< transformation from world space to local space for timestep 0
     AffineSpace3fa local2world[1]; //!< transformation from local space to world space for each timestep
   };
@@ -0,0 +1,103 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! stores the active lanes of v to ptr[0..n-1] */
+    template<typename vbool, typename vfloat>
+      __forceinline void storeN(const vbool& valid, float* ptr, const vfloat& v, const size_t n)
+    {
+      if (likely(n == vfloat::size)) vfloat::storeu(valid,ptr,v);
+      else for (size_t k=0; k<n; k++) if (valid[k]) ptr[k] = v[k];
+    }
+
+    /*! Interpolates the vertex data of triangles (N=3) or quads (N=4)
+     *  at the u/v locations of vfloat::size many primitives at once. The
+     *  vertex data of all lanes gets gathered float by float and the
+     *  results are stored in SOA layout, thus each lane can refer to a
+     *  different primitive. The getIndex(primID,i) closure returns the
+     *  index of the i'th vertex of some primitive. */
+    template<int N, typename vbool, typename vint, typename vfloat, typename GetIndex>
+      void interpolateN(const int* valid, const unsigned* primIDs, const float* u, const float* v, size_t numUVs,
+                        const char* src, size_t stride, const GetIndex& getIndex,
+                        float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats)
+    {
+      const size_t K = vfloat::size;
+      for (size_t i=0; i<numUVs; i+=K)
+      {
+        /* calculate vertex pointers of all lanes, inactive lanes point to the first vertex */
+        const size_t n = min(K,numUVs-i);
+        __aligned(64) int active[K];
+        __aligned(64) float uk[K], vk[K];
+        const char* vtx[N][K];
+        for (size_t k=0; k<K; k++)
+        {
+          const size_t j = i+k;
+          active[k] = k < n && (!valid || valid[j]) ? -1 : 0;
+          uk[k] = active[k] ? u[j] : 0.0f;
+          vk[k] = active[k] ? v[j] : 0.0f;
+          for (size_t l=0; l<N; l++)
+            vtx[l][k] = active[k] ? src+getIndex(primIDs[j],l)*stride : src;
+        }
+        const vbool valid1 = vint::load(active) != vint(zero);
+        if (none(valid1)) continue;
+
+        /* triangles use the first triangle of the quad formula only */
+        const vfloat uu = vfloat::load(uk);
+        const vfloat vv = vfloat::load(vk);
+        const vbool left = N == 3 ? vbool(True) : uu+vv <= 1.0f;
+        const vfloat U = select(left,uu,vfloat(1.0f)-uu);
+        const vfloat V = select(left,vv,vfloat(1.0f)-vv);
+        const vfloat W = 1.0f-U-V;
+
+        for (size_t f=0; f<numFloats; f++)
+        {
+          /* gather f'th float of all vertices */
+          const size_t ofs = f*sizeof(float);
+          vfloat p[N];
+          for (size_t l=0; l<N; l++) {
+            __aligned(64) float pk[K];
+            for (size_t k=0; k<K; k++) pk[k] = *(const float*)(vtx[l][k]+ofs);
+            p[l] = vfloat::load(pk);
+          }
+          const vfloat Q0 = N == 3 ? p[0] : select(left,p[0],p[N-2]);
+          const vfloat Q1 = N == 3 ? p[1] : select(left,p[1],p[N-1]);
+          const vfloat Q2 = N == 3 ? p[2] : select(left,p[N-1],p[1]);
+
+          const size_t dst = f*numUVs+i;
+          if (P) {
+            storeN(valid1,P+dst,W*Q0 + U*Q1 + V*Q2,n);
+          }
+          if (dPdu) {
+            assert(dPdu); storeN(valid1,dPdu+dst,select(left,Q1-Q0,Q0-Q1),n);
+            assert(dPdv); storeN(valid1,dPdv+dst,select(left,Q2-Q0,Q0-Q2),n);
+          }
+          if (ddPdudu) {
+            assert(ddPdudu); storeN(valid1,ddPdudu+dst,vfloat(zero),n);
+            assert(ddPdvdv); storeN(valid1,ddPdvdv+dst,vfloat(zero),n);
+            assert(ddPdudv); storeN(valid1,ddPdudv+dst,vfloat(zero),n);
+          }
+        }
+      }
+    }
+  }
+}
@@ -163,6 +163,24 @@ namespace embree
                                    itimeGlobal, numTimeStepsGlobal, numTimeSteps, bbox);
     }
 
+    /*! calculates the linear bounds of the i'th primitive for the specified time range */
+    __forceinline LBBox3fa linearBounds(size_t i, const BBox1f& time_range) const
+    {
+      return Geometry::linearBounds([&] (size_t itime) { return bounds(i, itime); }, time_range, fnumTimeSegments);
+    }
+
+    /*! calculates the build bounds of the i'th primitive for the specified time range, if it's valid */
+    __forceinline bool buildBounds(size_t i, const BBox1f& time_range, BBox3fa& bbox) const
+    {
+      return Geometry::buildBounds([&] (size_t itime, BBox3fa& bbox) -> bool
+                                   {
+                                     if (unlikely(!valid(i, itime))) return false;
+                                     bbox = bounds(i, itime);
+                                     return true;
+                                   },
+                                   time_range, fnumTimeSegments, bbox);
+    }
+
   public:
     APIBuffer<unsigned int> segments;                 //!< array of line segment indices
     BufferRefT<Vec3fa> vertices0;                     //!< fast access to first vertex buffer
@@ -18,13 +18,33 @@
 #include "scene.h"
 #include "../subdiv/patch_eval.h"
 #include "../subdiv/patch_eval_simd.h"
+#include "../subdiv/tessellation_cache_file.h"
 
 #include "../../common/algorithms/parallel_sort.h"
 #include "../../common/algorithms/parallel_prefix_sum.h"
 #include "../../common/algorithms/parallel_for.h"
+#include "../../common/algorithms/parallel_reduce.h"
 
 namespace embree
 {
+  /* changes of these buffers only invalidate the tessellation cache
+   * entries of modified faces, which is decided when the half edges
+   * get initialized */
+  static __forceinline bool isTopologyPreservingBuffer(RTCBufferType type)
+  {
+    if (type >= RTC_VERTEX_BUFFER0 && type <= RTC_VERTEX_BUFFER1) 
+      return true;
+
+    switch (type) {
+    case RTC_EDGE_CREASE_INDEX_BUFFER   : return true;
+    case RTC_EDGE_CREASE_WEIGHT_BUFFER  : return true;
+    case RTC_VERTEX_CREASE_INDEX_BUFFER : return true;
+    case RTC_VERTEX_CREASE_WEIGHT_BUFFER: return true;
+    case RTC_LEVEL_BUFFER               : return true;
+    default                             : return false;
+    }
+  }
+
   SubdivMesh::SubdivMesh (Scene* parent, RTCGeometryFlags flags, size_t numFaces, size_t numEdges, size_t numVertices, 
 			  size_t numEdgeCreases, size_t numVertexCreases, size_t numHoles, size_t numTimeSteps)
     : Geometry(parent,SUBDIV_MESH,numFaces,numTimeSteps,flags), 
@@ -34,16 +54,26 @@ namespace embree
       boundary(RTC_BOUNDARY_EDGE_ONLY),
       displFunc(nullptr),
       displFunc2(nullptr),
+      displBatchFunc(nullptr),
       displBounds(empty),
       tessellationRate(2.0f),
       numHalfEdges(0),
       faceStartEdge(parent->device),
       halfEdges(parent->device),
       invalid_face(parent->device),
-      levelUpdate(false)
+      levelUpdate(false),
+      topologyUpdate(false),
+      lastBoundary(RTC_BOUNDARY_EDGE_ONLY),
+      lastVertices(parent->device),
+      modified_vertices(parent->device),
+      modified_faces(parent->device),
+      hash(0),
+      patch_table_alloc(parent->device),
+      patchTableCommitCounter(-1)
   {
     vertices.resize(numTimeSteps);
     vertex_buffer_tags.resize(numTimeSteps);
+    vertex_buffer_patches.resize(numTimeSteps);
     for (size_t i=0; i<numTimeSteps; i++)
       vertices[i].init(parent->device,numVertices,sizeof(Vec3fa));
 
@@ -100,7 +130,7 @@ namespace embree
     if (((size_t(ptr) + offset) & 0x3) || (stride & 0x3)) 
       throw_RTCError(RTC_INVALID_OPERATION,"data must be 4 bytes aligned");
 
-    if (type != RTC_LEVEL_BUFFER)
+    if (!isTopologyPreservingBuffer(type))
       parent->commitCounterSubdiv++;
 
     if (type >= RTC_VERTEX_BUFFER0 && type < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) 
@@ -202,7 +232,7 @@ namespace embree
 
   void SubdivMesh::updateBuffer (RTCBufferType type)
   {
-    if (type != RTC_LEVEL_BUFFER)
+    if (!isTopologyPreservingBuffer(type))
       parent->commitCounterSubdiv++;
 
     if (type >= RTC_VERTEX_BUFFER0 && type < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) {
@@ -245,6 +275,16 @@ namespace embree
     else        this->displBounds = empty;
   }
 
+  void SubdivMesh::setDisplacementBatchFunction (RTCDisplacementBatchFunc func, RTCBounds* bounds) 
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    this->displBatchFunc = func;
+    if (bounds) this->displBounds = *(BBox3fa*)bounds; 
+    else        this->displBounds = empty;
+  }
+
   void SubdivMesh::setTessellationRate(float N)
   {
     if (parent->isStatic() && parent->isBuild()) 
@@ -254,6 +294,23 @@ namespace embree
     levels.setModified(true);
   }
 
+  void SubdivMesh::setTessellationCameras(const RTCTessellationCamera* cameras, size_t numCameras, float edgeLength)
+  {
+    if (parent->isStatic() && parent->isBuild()) 
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+
+    if (numCameras && cameras == nullptr)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid camera array");
+
+    if (numCameras && !(edgeLength > 0.0f))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"edge length has to be positive");
+
+    tessellationCameras.clear();
+    for (size_t i=0; i<numCameras; i++)
+      tessellationCameras.push_back(TessellationCamera(cameras[i],edgeLength));
+    updateBuffer(RTC_LEVEL_BUFFER);
+  }
+
   void SubdivMesh::immutable () 
   {
     const bool freeIndices = !parent->needSubdivIndices;
@@ -408,7 +465,7 @@ namespace embree
     /* calculate which data to update */
     const bool updateEdgeCreases = edge_creases.isModified() || edge_crease_weights.isModified();
     const bool updateVertexCreases = vertex_creases.isModified() || vertex_crease_weights.isModified(); 
-    const bool updateLevels = levels.isModified();
+    const bool updateLevels = levels.isModified() && !hasTessellationCameras(); // camera based levels get calculated by the builder
 
     /* parallel loop over all half edges */
     parallel_for( size_t(0), numHalfEdges, size_t(4096), [&](const range<size_t>& r) 
@@ -417,6 +474,8 @@ namespace embree
       {
 	HalfEdge& edge = halfEdges[i];
 	const unsigned int startVertex = edge.vtx_index;
+        const float edge_crease_weight = edge.edge_crease_weight;
+        const float vertex_crease_weight = edge.vertex_crease_weight;
  
 	if (updateLevels)
 	  edge.edge_level = getEdgeLevel(i); 
@@ -434,11 +493,166 @@ namespace embree
             edge.vertex_crease_weight = float(inf);
         }
 
-        if (updateEdgeCreases || updateVertexCreases) {
-          edge.patch_type = edge.patchType();
+        /* patches around vertices with changed creases need to get updated */
+        if (topologyUpdate) 
+        {
+          if (edge.edge_crease_weight != edge_crease_weight) {
+            modified_vertices[startVertex] = 1;
+            modified_vertices[edge.next()->vtx_index] = 1;
+          }
+          if (edge.vertex_crease_weight != vertex_crease_weight)
+            modified_vertices[startVertex] = 1;
+        }
+      }
+    });
+
+    /* patch types depend on the creases of neighboring half edges, thus can only get calculated after all creases got updated */
+    if (updateEdgeCreases || updateVertexCreases)
+    {
+      parallel_for( size_t(0), numHalfEdges, size_t(4096), [&](const range<size_t>& r) 
+      {
+        for (size_t i=r.begin(); i!=r.end(); i++)
+          halfEdges[i].patch_type = halfEdges[i].patchType();
+      });
+    }
+  }
+
+  bool SubdivMesh::updateModifiedFaces(bool verticesModified)
+  {
+    /* mark moved vertices and update faces that got valid or invalid */
+    if (verticesModified)
+    {
+      parallel_for( size_t(0), numVertices, size_t(4096), [&](const range<size_t>& r) 
+      {
+        for (size_t v=r.begin(); v!=r.end(); v++) 
+        {
+          const Vec3fa p = vertices[0][v];
+          const Vec3fa& q = lastVertices[v];
+          if (p.x != q.x || p.y != q.y || p.z != q.z) {
+            modified_vertices[v] = 1;
+            lastVertices[v] = p;
+          }
+        }
+      });
+
+      const bool validityChanged = parallel_reduce( size_t(0), numFaces, size_t(4096), false, [&](const range<size_t>& r) -> bool
+      {
+        bool changed = false;
+        for (size_t f=r.begin(); f!=r.end(); f++) 
+        {
+          const char invalid = !getHalfEdge(f)->valid(vertices[0]) || holeSet.lookup(unsigned(f));
+          changed |= invalid != invalidFace(f);
+          invalidFace(f) = invalid;
+        }
+        return changed;
+      }, [](const bool a, const bool b) { return a || b; });
+      
+      if (validityChanged) 
+        return false;
+    }
+
+    /* faces that contain a modified vertex */
+    modified_faces.resize(numFaces);
+    parallel_for( size_t(0), numFaces, size_t(4096), [&](const range<size_t>& r) 
+    {
+      for (size_t f=r.begin(); f!=r.end(); f++) 
+      {
+        const HalfEdge* edge = getHalfEdge(f);
+        char modified = 0;
+        for (size_t i=0; i<faceVertices[f]; i++)
+          modified |= modified_vertices[edge[i].vtx_index];
+        modified_faces[f] = modified;
+      }
+    });
+
+    /* all vertices of these faces are in the 1-ring of the modified vertices */
+    parallel_for( size_t(0), numFaces, size_t(4096), [&](const range<size_t>& r) 
+    {
+      for (size_t f=r.begin(); f!=r.end(); f++) 
+      {
+        if (!modified_faces[f]) continue;
+        const HalfEdge* edge = getHalfEdge(f);
+        for (size_t i=0; i<faceVertices[f]; i++)
+          modified_vertices[edge[i].vtx_index] = 1;
+      }
+    });
+
+    /* the limit surface of a face depends on the 1-ring of its vertices */
+    parallel_for( size_t(0), numFaces, size_t(4096), [&](const range<size_t>& r) 
+    {
+      for (size_t f=r.begin(); f!=r.end(); f++) 
+      {
+        const HalfEdge* edge = getHalfEdge(f);
+        char modified = 0;
+        for (size_t i=0; i<faceVertices[f]; i++)
+          modified |= modified_vertices[edge[i].vtx_index];
+        modified_faces[f] = modified;
+      }
+    });
+    return true;
+  }
+
+  void SubdivMesh::initializePatchTable(bool modified)
+  {
+    /* the patch table is only used for interpolation */
+    if (!parent->isInterpolatable() || !parent->device->subdiv_patch_table) 
+    {
+      for (auto& table : vertex_buffer_patches) table.clear();
+      for (auto& table : user_buffer_patches) table.clear();
+      patch_eval_trees.clear();
+      patch_table_alloc.clear();
+      patchTableCommitCounter = -1;
+      return;
+    }
+
+    /* changing the edge levels keeps the patch hierarchies */
+    if (!modified) return;
+    patchTableCommitCounter = parent->commitCounterSubdiv;
+
+    size_t numSlots = 0;
+    for (size_t t=0; t<numTimeSteps; t++) numSlots += numInterpolationSlots4(vertices[t].getStride());
+    for (size_t i=0; i<2; i++) if (userbuffers[i]) numSlots += numInterpolationSlots4(userbuffers[i]->getStride());
+    patch_table_alloc.init_estimate(numFaces*(numSlots+numTimeSteps)*sizeof(Patch4f::BSplinePatch));
+
+    /* builds the patch hierarchy of each face and slot of some buffer */
+    auto buildTable = [&] (std::vector<Patch4f::Ref>& table, const char* src, size_t stride)
+    {
+      const size_t slots = numInterpolationSlots4(stride);
+      table.resize(numFaces*slots);
+      parallel_for( size_t(0), numFaces, size_t(256), [&](const range<size_t>& r) 
+      {
+        FastAllocator::ThreadLocal* alloc = patch_table_alloc.threadLocal();
+        auto malloc = [&] (size_t bytes) { return alloc->malloc(bytes,64); };
+        for (size_t f=r.begin(); f!=r.end(); f++) 
+          for (size_t s=0; s<slots; s++)
+            table[f*slots+s] = valid(f) ? Patch4f::create(malloc,getHalfEdge(f),src+s*16,stride) : Patch4f::Ref();
+      });
+    };
+    for (size_t t=0; t<numTimeSteps; t++)
+      buildTable(vertex_buffer_patches[t],vertices[t].getPtr(),vertices[t].getStride());
+    for (size_t i=0; i<2; i++) {
+      if (userbuffers[i]) buildTable(user_buffer_patches[i],userbuffers[i]->getPtr(),userbuffers[i]->getStride());
+      else user_buffer_patches[i].clear();
+    }
+
+    /* position patch hierarchies of faces that are not represented by a single regular patch during grid evaluation */
+    patch_eval_trees.resize(numFaces*numTimeSteps);
+    parallel_for( size_t(0), numFaces, size_t(256), [&](const range<size_t>& r) 
+    {
+      FastAllocator::ThreadLocal* alloc = patch_table_alloc.threadLocal();
+      auto malloc = [&] (size_t bytes) { return alloc->malloc(bytes,64); };
+      for (size_t f=r.begin(); f!=r.end(); f++) 
+      {
+        const HalfEdge* edge = getHalfEdge(f);
+        for (size_t t=0; t<numTimeSteps; t++)
+        {
+          Patch3fa::Ref& tree = patch_eval_trees[f*numTimeSteps+t];
+          if (!valid(f) || edge->patch_type == HalfEdge::REGULAR_QUAD_PATCH) tree = Patch3fa::Ref();
+          else tree = Patch3fa::create(malloc,edge,vertices[t].getPtr(),vertices[t].getStride());
         }
       }
     });
+    patch_table_alloc.cleanup();
   }
 
   void SubdivMesh::initializeHalfEdgeStructures ()
@@ -482,10 +696,44 @@ namespace embree
     /* check whether we can simply update the bvh in cached mode */
     levelUpdate = !recalculate && edge_creases.size() == 0 && vertex_creases.size() == 0 && levels.isModified();
 
+    /* check if only vertex positions, creases, or edge levels changed,
+     * then the patches of unmodified faces can get reused */
+    bool verticesModified = false;
+    for (auto& buffer : vertices) verticesModified |= buffer.isModified();
+    const bool creasesModified = edge_creases.isModified() || edge_crease_weights.isModified() || vertex_creases.isModified() || vertex_crease_weights.isModified();
+    const bool trackVertices = !parent->isStatic() && numTimeSteps == 1;
+    topologyUpdate = trackVertices && !recalculate && (update || verticesModified) && boundary == lastBoundary && lastVertices.size() == numVertices;
+    if (topologyUpdate) {
+      modified_vertices.resize(numVertices);
+      parallel_for( size_t(0), numVertices, size_t(4096), [&](const range<size_t>& r) {
+          for (size_t v=r.begin(); v!=r.end(); v++) modified_vertices[v] = 0;
+        });
+    }
+
     /* now either recalculate or update the half edges */
     if (recalculate) calculateHalfEdges();
     else if (update) updateHalfEdges();
 
+    /* find the faces whose patches changed, otherwise invalidate all tessellation cache entries of the scene */
+    if (topologyUpdate) 
+      topologyUpdate = updateModifiedFaces(verticesModified);
+    if (!topologyUpdate && (verticesModified || creasesModified))
+      parent->commitCounterSubdiv++;
+
+    /* remember vertex positions to detect moved vertices with the next update */
+    if (trackVertices && !topologyUpdate) 
+    {
+      lastVertices.resize(numVertices);
+      parallel_for( size_t(0), numVertices, size_t(4096), [&](const range<size_t>& r) {
+          for (size_t v=r.begin(); v!=r.end(); v++) lastVertices[v] = vertices[0][v];
+        });
+    }
+    lastBoundary = boundary;
+
+    /* identify the mesh in the tessellation cache file */
+    if (parent->device->tessellation_cache_file)
+      hash = calculateHash();
+
     /* create interpolation cache mapping for interpolatable meshes */
     if (parent->isInterpolatable()) 
     {
@@ -502,8 +750,28 @@ namespace embree
         vertex_buffer_tags[i].resize(numFaces*numInterpolationSlots(vertices[i].getStride()));
       for (size_t i=0; i<2; i++)
         if (userbuffers[i]) user_buffer_tags  [i].resize(numFaces*numInterpolationSlots(userbuffers[i]->getStride()));
+
+      /* invalidate interpolation cache entries of modified faces */
+      if (topologyUpdate)
+      {
+        auto invalidate = [&] (std::vector<SharedLazyTessellationCache::CacheEntry>& tags) 
+        {
+          if (tags.size() == 0) return;
+          const size_t slots = tags.size()/numFaces;
+          parallel_for( size_t(0), numFaces, size_t(4096), [&](const range<size_t>& r) {
+              for (size_t f=r.begin(); f!=r.end(); f++) 
+                if (modified_faces[f])
+                  for (size_t i=0; i<slots; i++) tags[f*slots+i].tag = SharedLazyTessellationCache::Tag();
+            });
+        };
+        invalidate(vertex_buffer_tags[0]);
+        for (size_t i=0; i<2; i++) invalidate(user_buffer_tags[i]);
+      }
     }
 
+    /* precalculate patch hierarchies for interpolation */
+    initializePatchTable(recalculate || verticesModified || creasesModified || patchTableCommitCounter != parent->commitCounterSubdiv);
+
     /* cleanup some state for static scenes */
     if (parent->isStatic()) 
     {
@@ -551,6 +819,43 @@ namespace embree
     }
   }
 
+  template<typename T>
+  static uint64_t hashBuffer(const APIBuffer<T>& buffer, uint64_t hash)
+  {
+    for (size_t i=0; i<buffer.size(); i++) {
+      const T v = buffer[i];
+      hash = hashBytes(&v,sizeof(T),hash);
+    }
+    return hash;
+  }
+
+  uint64_t SubdivMesh::calculateHash() const
+  {
+    const size_t info[4] = { numFaces, numVertices, numTimeSteps, size_t(boundary) };
+    uint64_t h = hashBytes(info,sizeof(info));
+    h = hashBuffer(faceVertices,h);
+    h = hashBuffer(vertexIndices,h);
+    h = hashBuffer(holes,h);
+    h = hashBuffer(edge_creases,h);
+    h = hashBuffer(edge_crease_weights,h);
+    h = hashBuffer(vertex_creases,h);
+    h = hashBuffer(vertex_crease_weights,h);
+
+    /* the 4th vertex component is not used, thus may contain garbage */
+    for (const auto& buffer : vertices) {
+      for (size_t i=0; i<buffer.size(); i++) {
+        const Vec3fa v = buffer[i];
+        const float xyz[3] = { v.x, v.y, v.z };
+        h = hashBytes(xyz,sizeof(xyz),h);
+      }
+    }
+
+    /* the displacement function itself cannot get identified across processes */
+    const bool displ = displFunc || displFunc2 || displBatchFunc;
+    h = hashBytes(&displ,sizeof(displ),h);
+    return h;
+  }
+
   bool SubdivMesh::verify () 
   {
     /*! verify consistent size of vertex arrays */
@@ -608,18 +913,29 @@ namespace embree
       stride = vertices[bufID].getStride();
       baseEntry = &vertex_buffer_tags[bufID];
     }
+    const Patch4f::Ref* table = getPatchTable(buffer);
 
     for (size_t i=0; i<numFloats; i+=4)
     {
       vfloat4 Pt, dPdut, dPdvt, ddPdudut, ddPdvdvt, ddPdudvt;
-      isa::PatchEval<vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,i/4,stride)),parent->commitCounterSubdiv,
-                                      getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
-                                      P ? &Pt : nullptr, 
-                                      dPdu ? &dPdut : nullptr, 
-                                      dPdv ? &dPdvt : nullptr,
-                                      ddPdudu ? &ddPdudut : nullptr, 
-                                      ddPdvdv ? &ddPdvdvt : nullptr, 
-                                      ddPdudv ? &ddPdudvt : nullptr);
+      if (table)
+        isa::PatchEval<vfloat4,vfloat4>(table[numInterpolationSlots4(stride)*primID+i/4],
+                                        getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
+                                        P ? &Pt : nullptr, 
+                                        dPdu ? &dPdut : nullptr, 
+                                        dPdv ? &dPdvt : nullptr,
+                                        ddPdudu ? &ddPdudut : nullptr, 
+                                        ddPdvdv ? &ddPdvdvt : nullptr, 
+                                        ddPdudv ? &ddPdudvt : nullptr);
+      else
+        isa::PatchEval<vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,i/4,stride)),parent->commitCounterSubdiv,
+                                        getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
+                                        P ? &Pt : nullptr, 
+                                        dPdu ? &dPdut : nullptr, 
+                                        dPdv ? &dPdvt : nullptr,
+                                        ddPdudu ? &ddPdudut : nullptr, 
+                                        ddPdvdv ? &ddPdvdvt : nullptr, 
+                                        ddPdudv ? &ddPdudvt : nullptr);
 
       if (P) {
         for (size_t j=i; j<min(i+4,numFloats); j++) 
@@ -669,6 +985,7 @@ namespace embree
       baseEntry = &vertex_buffer_tags[bufID];
     }
 
+    const Patch4f::Ref* table = getPatchTable(buffer);
     const int* valid = (const int*) valid_i;
     
     for (size_t i=0; i<numUVs; i+=4) 
@@ -686,15 +1003,26 @@ namespace embree
         for (size_t j=0; j<numFloats; j+=4) 
         {
           const size_t M = min(size_t(4),numFloats-j);
-          isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,j/4,stride)),parent->commitCounterSubdiv,
-                                                           getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
-                                                           P ? P+j*numUVs+i : nullptr,
-                                                           dPdu ? dPdu+j*numUVs+i : nullptr,
-                                                           dPdv ? dPdv+j*numUVs+i : nullptr,
-                                                           ddPdudu ? ddPdudu+j*numUVs+i : nullptr,
-                                                           ddPdvdv ? ddPdvdv+j*numUVs+i : nullptr,
-                                                           ddPdudv ? ddPdudv+j*numUVs+i : nullptr,
-                                                           numUVs,M);
+          if (table)
+            isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4>(table[numInterpolationSlots4(stride)*primID+j/4],
+                                                             getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
+                                                             P ? P+j*numUVs+i : nullptr,
+                                                             dPdu ? dPdu+j*numUVs+i : nullptr,
+                                                             dPdv ? dPdv+j*numUVs+i : nullptr,
+                                                             ddPdudu ? ddPdudu+j*numUVs+i : nullptr,
+                                                             ddPdvdv ? ddPdvdv+j*numUVs+i : nullptr,
+                                                             ddPdudv ? ddPdudv+j*numUVs+i : nullptr,
+                                                             numUVs,M);
+          else
+            isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,j/4,stride)),parent->commitCounterSubdiv,
+                                                             getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
+                                                             P ? P+j*numUVs+i : nullptr,
+                                                             dPdu ? dPdu+j*numUVs+i : nullptr,
+                                                             dPdv ? dPdv+j*numUVs+i : nullptr,
+                                                             ddPdudu ? ddPdudu+j*numUVs+i : nullptr,
+                                                             ddPdvdv ? ddPdvdv+j*numUVs+i : nullptr,
+                                                             ddPdudv ? ddPdudv+j*numUVs+i : nullptr,
+                                                             numUVs,M);
         }
       });
     }
@@ -18,6 +18,7 @@
 
 #include "geometry.h"
 #include "buffer.h"
+#include "alloc.h"
 #include "../subdiv/half_edge.h"
 #include "../subdiv/tessellation_cache.h"
 #include "../subdiv/catmullclark_coefficients.h"
@@ -91,10 +92,12 @@ namespace embree
     void update ();
     void updateBuffer (RTCBufferType type);
     void setTessellationRate(float N);
+    void setTessellationCameras(const RTCTessellationCamera* cameras, size_t numCameras, float edgeLength);
     void immutable ();
     bool verify ();
     void setDisplacementFunction (RTCDisplacementFunc func, RTCBounds* bounds);
     void setDisplacementFunction2 (RTCDisplacementFunc2 func, RTCBounds* bounds);
+    void setDisplacementBatchFunction (RTCDisplacementBatchFunc func, RTCBounds* bounds);
     void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
     void interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
                       RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
@@ -140,6 +143,13 @@ namespace embree
     /*! updates half edges when recalculation is not necessary */
     void updateHalfEdges();
 
+    /*! marks the faces whose limit surface changed with a topology preserving update,
+     *  returns false if the validity of some face changed */
+    bool updateModifiedFaces(bool verticesModified);
+
+    /*! builds the patch table if some vertex data, crease, or the topology changed */
+    void initializePatchTable(bool modified);
+
   public:
 
     /*! returns the start half edge for some face */
@@ -155,6 +165,12 @@ namespace embree
      /* check for simple edge level update */
     __forceinline bool checkLevelUpdate() const { return levelUpdate; }
 
+    /* checks if the last update preserved the topology, then only patches of modified faces need to get updated */
+    __forceinline bool checkTopologyUpdate() const { return topologyUpdate; }
+
+    /* checks if the limit surface of some face changed with the last topology preserving update */
+    __forceinline bool faceModified(const size_t f) const { return modified_faces[f]; }
+
     /* returns tessellation level of edge */
     __forceinline float getEdgeLevel(const size_t i) const
     {
@@ -162,6 +178,32 @@ namespace embree
       else return clamp(tessellationRate,1.0f,4096.0f); // FIXME: do we want to limit edge level?
     }
 
+    /* checks if the edge levels get calculated from tessellation cameras */
+    __forceinline bool hasTessellationCameras() const { return tessellationCameras.size() != 0; }
+
+    /* returns tessellation level of the edge between two vertices as seen from the tessellation cameras */
+    __forceinline float getCameraEdgeLevel(const unsigned v0, const unsigned v1) const
+    {
+      float level = 1.0f;
+      for (size_t t=0; t<numTimeSteps; t++)
+      {
+        const Vec3fa p0 = vertices[t][v0];
+        const Vec3fa p1 = vertices[t][v1];
+        for (const TessellationCamera& camera : tessellationCameras)
+          level = max(level,camera.edgeLevel(p0,p1));
+      }
+      return min(level,4096.0f);
+    }
+
+    /* updates the tessellation levels of all edges of face f from the tessellation cameras, 
+     * the level only depends on the edge itself thus neighboring faces stay crack free */
+    __forceinline void updateCameraEdgeLevels(const size_t f)
+    {
+      HalfEdge* edge = &halfEdges[faceStartEdge[f]];
+      for (size_t i=0; i<faceVertices[f]; i++)
+        edge[i].edge_level = getCameraEdgeLevel(edge[i].vtx_index,edge[i].next()->vtx_index);
+    }
+
   private:
     size_t numFaces;           //!< number of faces
     size_t numEdges;           //!< number of edges
@@ -171,6 +213,7 @@ namespace embree
   public:
     RTCDisplacementFunc displFunc;    //!< displacement function
     RTCDisplacementFunc2 displFunc2;    //!< displacement function
+    RTCDisplacementBatchFunc displBatchFunc;  //!< batched displacement function, has precedence over displFunc and displFunc2
     BBox3fa             displBounds;  //!< bounds for maximal displacement 
 
     /*! all buffers in this section are provided by the application */
@@ -204,6 +247,44 @@ namespace embree
     APIBuffer<float> levels;
     float tessellationRate;  // constant rate that is used when levels is not set
 
+    /*! camera used to calculate edge levels from the projected edge length */
+    struct TessellationCamera
+    {
+      TessellationCamera (const RTCTessellationCamera& camera, float edgeLength)
+        : row0(camera.xfm[0],camera.xfm[4],camera.xfm[8 ],camera.xfm[12]),
+          row1(camera.xfm[1],camera.xfm[5],camera.xfm[9 ],camera.xfm[13]),
+          row3(camera.xfm[3],camera.xfm[7],camera.xfm[11],camera.xfm[15]),
+          scale(0.5f*camera.width/edgeLength,0.5f*camera.height/edgeLength) {}
+
+      /* returns the projected length of the edge (p0,p1) in units of the edge length, and zero if the edge is outside the view frustum */
+      __forceinline float edgeLevel(const Vec3fa& p0, const Vec3fa& p1) const
+      {
+        float x0 = dot(row0,Vec4f(p0.x,p0.y,p0.z,1.0f)), x1 = dot(row0,Vec4f(p1.x,p1.y,p1.z,1.0f));
+        float y0 = dot(row1,Vec4f(p0.x,p0.y,p0.z,1.0f)), y1 = dot(row1,Vec4f(p1.x,p1.y,p1.z,1.0f));
+        float w0 = dot(row3,Vec4f(p0.x,p0.y,p0.z,1.0f)), w1 = dot(row3,Vec4f(p1.x,p1.y,p1.z,1.0f));
+
+        /* cull edges that lie outside of some plane of the view frustum */
+        if (w0 <= 0.0f && w1 <= 0.0f) return 0.0f;
+        if (x0 < -w0 && x1 < -w1) return 0.0f;
+        if (x0 > +w0 && x1 > +w1) return 0.0f;
+        if (y0 < -w0 && y1 < -w1) return 0.0f;
+        if (y0 > +w0 && y1 > +w1) return 0.0f;
+
+        /* clip edges that cross the camera plane close to the camera */
+        const float wmin = 1E-3f*max(w0,w1);
+        if (w0 < wmin) { const float f = (wmin-w0)/(w1-w0); x0 += f*(x1-x0); y0 += f*(y1-y0); w0 = wmin; }
+        if (w1 < wmin) { const float f = (wmin-w1)/(w0-w1); x1 += f*(x0-x1); y1 += f*(y0-y1); w1 = wmin; }
+
+        const float dx = scale.x*(x1/w1-x0/w0);
+        const float dy = scale.y*(y1/w1-y0/w0);
+        return sqrt(dx*dx+dy*dy);
+      }
+
+      Vec4f row0,row1,row3;  //!< rows of world to clip space transformation required to project x and y
+      Vec2f scale;           //!< scales NDC coordinates to units of the target edge length in pixels
+    };
+    std::vector<TessellationCamera> tessellationCameras;
+
     /*! buffer that marks specific faces as holes */
     APIBuffer<unsigned> holes;
 
@@ -233,6 +314,30 @@ namespace embree
      *  allows for simple bvh update instead of full rebuild in cached mode */
     bool levelUpdate;
 
+    /*! flag whether only vertex positions, creases, and edge levels have changed,
+     *  allows to update modified patches in place instead of full rebuild in cached mode */
+    bool topologyUpdate;
+
+    /*! boundary mode used when the half edges got initialized the last time */
+    RTCBoundaryMode lastBoundary;
+
+    /*! vertex positions of the last commit, only stored for dynamic scenes without motion blur */
+    mvector<Vec3fa> lastVertices;
+
+    /*! marks vertices that moved or whose creases changed with the last commit */
+    mvector<char> modified_vertices;
+
+    /*! marks faces whose limit surface changed with the last commit */
+    mvector<char> modified_faces;
+
+    /*! calculates the hash over all mesh data that influences the tessellated grids */
+    uint64_t calculateHash() const;
+
+  public:
+
+    /*! identifies the mesh in the tessellation cache file, only calculated if such a file is used */
+    uint64_t hash;
+
     /*! interpolation cache */
   public:
     static __forceinline size_t numInterpolationSlots4(size_t stride) { return (stride+15)/16; }
@@ -248,7 +353,27 @@ namespace embree
     }
     std::vector<std::vector<SharedLazyTessellationCache::CacheEntry>> vertex_buffer_tags;
     std::vector<SharedLazyTessellationCache::CacheEntry> user_buffer_tags[2];
-    std::vector<Patch3fa::Ref> patch_eval_trees;
+
+    /*! patch table, stores the patch hierarchy of each face for all 4
+     *  float slots of the interpolated buffers and the vertex positions
+     *  of complex faces, built once at commit */
+  public:
+    typedef PatchT<vfloat4,vfloat4> Patch4f;
+
+    /*! returns the patch hierarchies of some buffer or nullptr if no patch table got built */
+    __forceinline const Patch4f::Ref* getPatchTable(RTCBufferType buffer) const 
+    {
+      const std::vector<Patch4f::Ref>& table = buffer >= RTC_USER_VERTEX_BUFFER0 ? user_buffer_patches[buffer&0xFFFF] : vertex_buffer_patches[buffer&0xFFFF];
+      return table.size() ? table.data() : nullptr;
+    }
+
+    std::vector<std::vector<Patch4f::Ref>> vertex_buffer_patches;
+    std::vector<Patch4f::Ref> user_buffer_patches[2];
+    std::vector<Patch3fa::Ref> patch_eval_trees;         //!< position patch hierarchies of complex faces used for grid evaluation
+  private:
+    FastAllocator patch_table_alloc;                     //!< allocates all patches of the patch table
+    size_t patchTableCommitCounter;                      //!< value of the commit counter when the patch table got built
+  public:
       
     /*! the following data is only required during construction of the
      *  half edge structure and can be cleared for static scenes */
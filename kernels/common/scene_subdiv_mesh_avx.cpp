@@ -48,20 +48,32 @@ namespace embree
       stride = vertices[buffer&0xFFFF].getStride();
       baseEntry = &vertex_buffer_tags[bufID];
     }
+    const Patch4f::Ref* table = getPatchTable(buffer);
 
     for (size_t i=0,slot=0; i<numFloats; slot++)
     {
-      if (i+4 >= numFloats)
+      /* the patch table stores patches of 4 float slots */
+      if (table || i+4 >= numFloats)
       {
         vfloat4 Pt, dPdut, dPdvt, ddPdudut, ddPdvdvt, ddPdudvt;; 
-        isa::PatchEval<vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
-                                getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
-                                P ? &Pt : nullptr, 
-                                dPdu ? &dPdut : nullptr, 
-                                dPdv ? &dPdvt : nullptr,
-                                ddPdudu ? &ddPdudut : nullptr, 
-                                ddPdvdv ? &ddPdvdvt : nullptr, 
-                                ddPdudv ? &ddPdudvt : nullptr);
+        if (table)
+          isa::PatchEval<vfloat4>(table[numInterpolationSlots4(stride)*primID+i/4],
+                                  getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
+                                  P ? &Pt : nullptr, 
+                                  dPdu ? &dPdut : nullptr, 
+                                  dPdv ? &dPdvt : nullptr,
+                                  ddPdudu ? &ddPdudut : nullptr, 
+                                  ddPdvdv ? &ddPdvdvt : nullptr, 
+                                  ddPdudv ? &ddPdudvt : nullptr);
+        else
+          isa::PatchEval<vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+                                  getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
+                                  P ? &Pt : nullptr, 
+                                  dPdu ? &dPdut : nullptr, 
+                                  dPdv ? &dPdvt : nullptr,
+                                  ddPdudu ? &ddPdudut : nullptr, 
+                                  ddPdvdv ? &ddPdvdvt : nullptr, 
+                                  ddPdudv ? &ddPdudvt : nullptr);
         
         if (P) {
           for (size_t j=i; j<min(i+4,numFloats); j++) 
@@ -141,23 +153,36 @@ namespace embree
       stride = vertices[bufID].getStride();
       baseEntry = &vertex_buffer_tags[bufID];
     }
+    const Patch4f::Ref* table = getPatchTable(buffer);
 
     foreach_unique(valid1,primID,[&](const vbool& valid1, const int primID) 
     {
       for (size_t j=0,slot=0; j<numFloats; slot++)
       {
-        if (j+4 >= numFloats)
+        /* the patch table stores patches of 4 float slots */
+        if (table || j+4 >= numFloats)
         {
           const size_t M = min(size_t(4),numFloats-j);
-          isa::PatchEvalSimd<vbool,vint,vfloat,vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
-                                                        getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
-                                                        P ? P+j*numUVs : nullptr,
-                                                        dPdu ? dPdu+j*numUVs : nullptr,
-                                                        dPdv ? dPdv+j*numUVs : nullptr,
-                                                        ddPdudu ? ddPdudu+j*numUVs : nullptr,
-                                                        ddPdvdv ? ddPdvdv+j*numUVs : nullptr,
-                                                        ddPdudv ? ddPdudv+j*numUVs : nullptr,
-                                                        numUVs,M);
+          if (table)
+            isa::PatchEvalSimd<vbool,vint,vfloat,vfloat4>(table[numInterpolationSlots4(stride)*primID+j/4],
+                                                          getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
+                                                          P ? P+j*numUVs : nullptr,
+                                                          dPdu ? dPdu+j*numUVs : nullptr,
+                                                          dPdv ? dPdv+j*numUVs : nullptr,
+                                                          ddPdudu ? ddPdudu+j*numUVs : nullptr,
+                                                          ddPdvdv ? ddPdvdv+j*numUVs : nullptr,
+                                                          ddPdudv ? ddPdudv+j*numUVs : nullptr,
+                                                          numUVs,M);
+          else
+            isa::PatchEvalSimd<vbool,vint,vfloat,vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+                                                          getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
+                                                          P ? P+j*numUVs : nullptr,
+                                                          dPdu ? dPdu+j*numUVs : nullptr,
+                                                          dPdv ? dPdv+j*numUVs : nullptr,
+                                                          ddPdudu ? ddPdudu+j*numUVs : nullptr,
+                                                          ddPdvdv ? ddPdvdv+j*numUVs : nullptr,
+                                                          ddPdudv ? ddPdudv+j*numUVs : nullptr,
+                                                          numUVs,M);
           j+=4;
         }
         else
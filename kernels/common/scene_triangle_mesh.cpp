@@ -16,6 +16,8 @@
 
 #include "scene_triangle_mesh.h"
 #include "scene.h"
+#include "scene_interpolate.h"
+#include "scene_vertex_welding.h"
 
 namespace embree
 {
@@ -135,6 +137,33 @@ namespace embree
         buffer.free();
   }
 
+  size_t TriangleMesh::weldVertices ()
+  {
+    /* we can only modify buffers that we own */
+    if (triangles.isShared() || !triangles || userbuffers[0] || userbuffers[1]) return 0;
+    for (const auto& buffer : vertices)
+      if (buffer.isShared() || !buffer) return 0;
+
+    const size_t numVertices0 = numVertices();
+    const size_t numVertices1 = weldMeshVertices(vertices,sizeof(Vec3f),[&] (const std::vector<unsigned>& remap)
+    {
+      parallel_for(size_t(0), triangles.size(), size_t(4096), [&](const range<size_t>& r)
+      {
+        for (size_t i=r.begin(); i<r.end(); i++)
+        {
+          Triangle& prim = (Triangle&) triangles[i];
+          for (size_t j=0; j<3; j++)
+            if (prim.v[j] < numVertices0) prim.v[j] = remap[prim.v[j]];
+        }
+      });
+    });
+
+    for (auto& buffer : vertices)
+      buffer.shrink(numVertices1);
+    vertices0 = vertices[0];
+    return (numVertices0-numVertices1)*vertices.size()*vertices[0].getStride();
+  }
+
   bool TriangleMesh::verify () 
   {
     /*! verify consistent size of vertex arrays */
@@ -204,4 +233,30 @@ namespace embree
       }
     }
   }
+
+  void TriangleMesh::interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                                  RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats)
+  {
+#if defined(DEBUG)
+    if ((parent->aflags & RTC_INTERPOLATE) == 0) 
+      throw_RTCError(RTC_INVALID_OPERATION,"rtcInterpolate can only get called when RTC_INTERPOLATE is enabled for the scene");
+#endif
+
+    /* calculate base pointer and stride */
+    assert((buffer >= RTC_VERTEX_BUFFER0 && buffer < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) ||
+           (buffer >= RTC_USER_VERTEX_BUFFER0 && buffer <= RTC_USER_VERTEX_BUFFER1));
+    const char* src = nullptr; 
+    size_t stride = 0;
+    if (buffer >= RTC_USER_VERTEX_BUFFER0) {
+      src    = userbuffers[buffer&0xFFFF]->getPtr();
+      stride = userbuffers[buffer&0xFFFF]->getStride();
+    } else {
+      src    = vertices[buffer&0xFFFF].getPtr();
+      stride = vertices[buffer&0xFFFF].getStride();
+    }
+
+    isa::interpolateN<3,vbool4,vint4,vfloat4>((const int*)valid_i,primIDs,u,v,numUVs,src,stride,
+                                              [&] (unsigned primID, size_t i) { return triangle(primID).v[i]; },
+                                              P,dPdu,dPdv,ddPdudu,ddPdvdv,ddPdudv,numFloats);
+  }
 }
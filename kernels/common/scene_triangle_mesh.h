@@ -110,9 +110,11 @@ namespace embree
     void* map(RTCBufferType type);
     void unmap(RTCBufferType type);
     void immutable ();
+    size_t weldVertices ();
     bool verify ();
     void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
-    // FIXME: implement interpolateN
+    void interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                      RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
 
   public:
 
@@ -250,6 +252,24 @@ namespace embree
                                    },
                                    itimeGlobal, numTimeStepsGlobal, numTimeSteps, bbox);
     }
+
+    /*! calculates the linear bounds of the i'th primitive for the specified time range */
+    __forceinline LBBox3fa linearBounds(size_t i, const BBox1f& time_range) const
+    {
+      return Geometry::linearBounds([&] (size_t itime) { return bounds(i, itime); }, time_range, fnumTimeSegments);
+    }
+
+    /*! calculates the build bounds of the i'th primitive for the specified time range, if it's valid */
+    __forceinline bool buildBounds(size_t i, const BBox1f& time_range, BBox3fa& bbox) const
+    {
+      return Geometry::buildBounds([&] (size_t itime, BBox3fa& bbox) -> bool
+                                   {
+                                     if (unlikely(!valid(i, itime))) return false;
+                                     bbox = bounds(i, itime);
+                                     return true;
+                                   },
+                                   time_range, fnumTimeSegments, bbox);
+    }
     
   public:
     APIBuffer<Triangle> triangles;                    //!< array of triangles
@@ -257,4 +277,13 @@ namespace embree
     vector<APIBuffer<Vec3fa>> vertices;               //!< vertex array for each timestep
     array_t<std::unique_ptr<APIBuffer<char>>,2> userbuffers; //!< user buffers // FIXME: no std::unique_ptr here
   };
+
+  class TriangleMeshAVX : public TriangleMesh
+  {
+  public:
+    TriangleMeshAVX (Scene* parent, RTCGeometryFlags flags, size_t numTriangles, size_t numVertices, size_t numTimeSteps);
+
+    void interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                      RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
+  };
 }
@@ -0,0 +1,114 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+#include "../../common/algorithms/parallel_sort.h"
+
+namespace embree
+{
+  /*! Welds all vertices that store bitwise identical data in all
+   *  vertex buffers. Only the first bytes of each vertex get
+   *  compared. The remaining vertices get compacted in place and the
+   *  remapIndices(remap) closure has to update the index buffer using
+   *  the remap table from old to new vertex indices. Returns the new
+   *  number of vertices, the buffers themselves do not get resized. */
+  template<typename Buffers, typename RemapIndices>
+    size_t weldMeshVertices(Buffers& buffers, size_t bytes, const RemapIndices& remapIndices)
+  {
+    struct KeyIndex
+    {
+      __forceinline KeyIndex () {}
+
+      __forceinline KeyIndex (uint64_t key, unsigned index)
+        : key(key), index(index) {}
+
+      __forceinline operator uint64_t() const {
+        return key;
+      }
+
+    public:
+      uint64_t key;
+      unsigned index;
+    };
+
+    const size_t N = buffers[0].size();
+    if (N < 2) return N;
+
+    auto equal = [&] (size_t i, size_t j) {
+      for (const auto& buffer : buffers)
+        if (memcmp(buffer.getPtr(i),buffer.getPtr(j),bytes) != 0) return false;
+      return true;
+    };
+
+    /* hash the data of each vertex */
+    std::vector<KeyIndex> keys0(N), keys1(N);
+    parallel_for(size_t(0), N, size_t(4096), [&](const range<size_t>& r)
+    {
+      for (size_t i=r.begin(); i<r.end(); i++)
+      {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const auto& buffer : buffers) {
+          const unsigned char* data = (const unsigned char*) buffer.getPtr(i);
+          for (size_t b=0; b<bytes; b++) hash = (hash ^ data[b]) * 0x100000001b3ull;
+        }
+        keys0[i] = KeyIndex(hash,unsigned(i));
+      }
+    });
+
+    /* sort vertices by hash to find identical ones */
+    radix_sort_u64(keys0.data(),keys1.data(),N);
+
+    /* map each vertex to the first identical vertex */
+    std::vector<unsigned> remap(N);
+    for (size_t i=0; i<N; i++) remap[i] = unsigned(i);
+
+    for (size_t b=0, e=0; b<N; b=e)
+    {
+      e = b+1;
+      while (e<N && keys0[e].key == keys0[b].key) e++;
+      if (e-b == 1) continue;
+
+      /* compare the actual data to handle hash collisions */
+      std::sort(&keys0[b],&keys0[e],[] (const KeyIndex& k0, const KeyIndex& k1) { return k0.index < k1.index; });
+      for (size_t i=b; i<e; i++)
+      {
+        const unsigned vi = keys0[i].index;
+        if (remap[vi] != vi) continue;
+        for (size_t j=i+1; j<e; j++) {
+          const unsigned vj = keys0[j].index;
+          if (remap[vj] == vj && equal(vi,vj)) remap[vj] = vi;
+        }
+      }
+    }
+
+    /* compact vertices in place, each vertex only moves towards the front */
+    size_t numVertices = 0;
+    for (size_t i=0; i<N; i++)
+    {
+      if (remap[i] != i) { remap[i] = remap[remap[i]]; continue; }
+      for (auto& buffer : buffers) {
+        if (numVertices != i)
+          memcpy((char*)buffer.getPtr(numVertices),buffer.getPtr(i),buffer.getStride());
+      }
+      remap[i] = unsigned(numVertices++);
+    }
+
+    if (numVertices != N) remapIndices(remap);
+    return numVertices;
+  }
+}
@@ -91,6 +91,11 @@ namespace embree
     max_spatial_split_replications = 2.0f;
 
     tessellation_cache_size = 128*1024*1024;
+    tessellation_cache_prefetch = 0;
+    tessellation_cache_file = "";
+    tessellation_cache_file_size = 1024*1024*1024;
+    subdiv_patch_table = true;
+    vertex_welding = false;
 
     /* large default cache size only for old mode single device mode */
 #if defined(__X86_64__)
@@ -117,6 +122,8 @@ namespace embree
     if (hasISA(AVX512KNL)) set_affinity = true;
 
     start_threads = false;
+    isolated_threads = false;
+    affinity_offset = 0;
 
     error_function = nullptr;
     memory_monitor_function = nullptr;
@@ -233,6 +240,12 @@ namespace embree
       
       else if (tok == Token::Id("start_threads")&& cin->trySymbol("=")) 
         start_threads = cin->get().Int();
+
+      else if (tok == Token::Id("isolated_threads")&& cin->trySymbol("=")) 
+        isolated_threads = cin->get().Int();
+
+      else if (tok == Token::Id("affinity_offset")&& cin->trySymbol("=")) 
+        affinity_offset = cin->get().Int();
       
       else if (tok == Token::Id("isa") && cin->trySymbol("=")) {
         std::string isa = toLowerCase(cin->get().Identifier());
@@ -350,6 +363,16 @@ namespace embree
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("tessellation_cache_prefetch") && cin->trySymbol("="))
+        tessellation_cache_prefetch = cin->get().Int();
+      else if (tok == Token::Id("tessellation_cache_file") && cin->trySymbol("="))
+        tessellation_cache_file = cin->get().String();
+      else if (tok == Token::Id("tessellation_cache_file_size") && cin->trySymbol("="))
+        tessellation_cache_file_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("subdiv_patch_table") && cin->trySymbol("="))
+        subdiv_patch_table = cin->get().Int();
+      else if (tok == Token::Id("vertex_welding") && cin->trySymbol("="))
+        vertex_welding = cin->get().Int();
 
       cin->trySymbol(","); // optional , separator
     }
@@ -365,8 +388,15 @@ namespace embree
     std::cout << "  build threads = " << numThreads   << std::endl;
     std::cout << "  start_threads = " << start_threads << std::endl;
     std::cout << "  affinity      = " << set_affinity << std::endl;
+    std::cout << "  affinity_offset = " << affinity_offset << std::endl;
+    std::cout << "  isolated_threads = " << isolated_threads << std::endl;
     std::cout << "  verbosity     = " << verbose << std::endl;
     std::cout << "  cache_size    = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  cache_prefetch = " << tessellation_cache_prefetch << std::endl;
+    if (tessellation_cache_file != "")
+      std::cout << "  cache_file    = " << tessellation_cache_file << " (" << float(tessellation_cache_file_size)*1E-6 << " MB)" << std::endl;
+    std::cout << "  patch_table   = " << subdiv_patch_table << std::endl;
+    std::cout << "  vertex_welding = " << vertex_welding << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
     
     std::cout << "triangles:" << std::endl;
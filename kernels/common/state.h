@@ -107,6 +107,11 @@ namespace embree
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    size_t tessellation_cache_prefetch;    //!< number of neighbouring patches whose grids get built together with a missing grid
+    std::string tessellation_cache_file;   //!< file that persistently stores tessellated grids, disabled if empty
+    size_t tessellation_cache_file_size;   //!< maximal size of the tessellation cache file
+    bool subdiv_patch_table;               //!< precalculate patch hierarchies of subdivision meshes at commit for interpolation
+    bool vertex_welding;                   //!< weld identical vertices of static triangle and quad meshes at commit
 
   public:
     bool float_exceptions;                 //!< enable floating point exceptions
@@ -118,6 +123,8 @@ namespace embree
     size_t numThreads;                     //!< number of threads to use in builders
     bool set_affinity;                     //!< sets affinity for worker threads
     bool start_threads;                    //!< true when threads should be started at device creation time
+    bool isolated_threads;                 //!< true when the device uses its own thread pool
+    size_t affinity_offset;                //!< first logical thread worker threads are pinned to
     int enabled_cpu_features;              //!< CPU ISA features to use
 
   public:
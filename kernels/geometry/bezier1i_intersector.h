@@ -45,7 +45,9 @@ namespace embree
         STAT3(normal.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) context->scene->get(prim.geomID());
         Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID);
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(ray.org,a0)))
+          pre.intersectorHair.intersectRibbon(ray,a0,a1,a2,a3,Intersect1EpilogMU<4,true>(ray,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,a0,a1,a2,a3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID()));
         else 
           pre.intersectorCurve.intersect(ray,a0,a1,a2,a3,Intersect1Epilog1<true>(ray,context,prim.geomID(),prim.primID()));
@@ -56,7 +58,9 @@ namespace embree
         STAT3(shadow.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) context->scene->get(prim.geomID());
         Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID);
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(ray.org,a0)))
+          return pre.intersectorHair.intersectRibbon(ray,a0,a1,a2,a3,Occluded1EpilogMU<4,true>(ray,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           return pre.intersectorHair.intersect(ray,a0,a1,a2,a3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID()));
         else
           return pre.intersectorCurve.intersect(ray,a0,a1,a2,a3,Occluded1Epilog1<true>(ray,context,prim.geomID(),prim.primID()));
@@ -103,7 +107,9 @@ namespace embree
         STAT3(normal.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) context->scene->get(prim.geomID());
         Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID);
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(Vec3fa(ray.org.x[k],ray.org.y[k],ray.org.z[k]),a0)))
+          pre.intersectorHair.intersectRibbon(ray,k,a0,a1,a2,a3,Intersect1KEpilogMU<4,K,true>(ray,k,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,k,a0,a1,a2,a3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID()));
         else 
           pre.intersectorCurve.intersect(ray,k,a0,a1,a2,a3,Intersect1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID()));
@@ -120,7 +126,9 @@ namespace embree
         STAT3(shadow.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) context->scene->get(prim.geomID());
         Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID);
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(Vec3fa(ray.org.x[k],ray.org.y[k],ray.org.z[k]),a0)))
+          return pre.intersectorHair.intersectRibbon(ray,k,a0,a1,a2,a3,Occluded1KEpilogMU<4,K,true>(ray,k,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           return pre.intersectorHair.intersect(ray,k,a0,a1,a2,a3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID()));
         else
           return pre.intersectorCurve.intersect(ray,k,a0,a1,a2,a3,Occluded1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID()));
@@ -161,7 +169,9 @@ namespace embree
         STAT3(normal.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) context->scene->get(prim.geomID());
         Vec3fa p0,p1,p2,p3; geom->gather(p0,p1,p2,p3,prim.vertexID,ray.time);
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(ray.org,p0)))
+          pre.intersectorHair.intersectRibbon(ray,p0,p1,p2,p3,Intersect1EpilogMU<4,true>(ray,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,p0,p1,p2,p3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID()));
         else 
           pre.intersectorCurve.intersect(ray,p0,p1,p2,p3,Intersect1Epilog1<true>(ray,context,prim.geomID(),prim.primID()));
@@ -172,7 +182,9 @@ namespace embree
         STAT3(shadow.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) context->scene->get(prim.geomID());
         Vec3fa p0,p1,p2,p3; geom->gather(p0,p1,p2,p3,prim.vertexID,ray.time);
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(ray.org,p0)))
+          return pre.intersectorHair.intersectRibbon(ray,p0,p1,p2,p3,Occluded1EpilogMU<4,true>(ray,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           return pre.intersectorHair.intersect(ray,p0,p1,p2,p3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID()));
         else
           return pre.intersectorCurve.intersect(ray,p0,p1,p2,p3,Occluded1Epilog1<true>(ray,context,prim.geomID(),prim.primID()));
@@ -205,7 +217,9 @@ namespace embree
         STAT3(normal.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) context->scene->get(prim.geomID());        
         Vec3fa p0,p1,p2,p3; geom->gather(p0,p1,p2,p3,prim.vertexID,ray.time[k]);
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(Vec3fa(ray.org.x[k],ray.org.y[k],ray.org.z[k]),p0)))
+          pre.intersectorHair.intersectRibbon(ray,k,p0,p1,p2,p3,Intersect1KEpilogMU<4,K,true>(ray,k,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,k,p0,p1,p2,p3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID()));
         else 
           pre.intersectorCurve.intersect(ray,k,p0,p1,p2,p3,Intersect1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID()));
@@ -216,7 +230,9 @@ namespace embree
         STAT3(shadow.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) context->scene->get(prim.geomID());
         Vec3fa p0,p1,p2,p3; geom->gather(p0,p1,p2,p3,prim.vertexID,ray.time[k]);
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(Vec3fa(ray.org.x[k],ray.org.y[k],ray.org.z[k]),p0)))
+          return pre.intersectorHair.intersectRibbon(ray,k,p0,p1,p2,p3,Occluded1KEpilogMU<4,K,true>(ray,k,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           return pre.intersectorHair.intersect(ray,k,p0,p1,p2,p3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID()));
         else
           return pre.intersectorCurve.intersect(ray,k,p0,p1,p2,p3,Occluded1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID()));
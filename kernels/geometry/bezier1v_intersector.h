@@ -47,7 +47,9 @@ namespace embree
       {
         STAT3(normal.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*)context->scene->get(prim.geomID());
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(ray.org,prim.p0)))
+          pre.intersectorHair.intersectRibbon(ray,prim.p0,prim.p1,prim.p2,prim.p3,Intersect1EpilogMU<4,true>(ray,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,prim.p0,prim.p1,prim.p2,prim.p3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID()));
         else 
           pre.intersectorCurve.intersect(ray,prim.p0,prim.p1,prim.p2,prim.p3,Intersect1Epilog1<true>(ray,context,prim.geomID(),prim.primID()));
@@ -57,7 +59,9 @@ namespace embree
       {
         STAT3(shadow.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*)context->scene->get(prim.geomID());
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(ray.org,prim.p0)))
+          return pre.intersectorHair.intersectRibbon(ray,prim.p0,prim.p1,prim.p2,prim.p3,Occluded1EpilogMU<4,true>(ray,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           return pre.intersectorHair.intersect(ray,prim.p0,prim.p1,prim.p2,prim.p3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID()));
         else
           return pre.intersectorCurve.intersect(ray,prim.p0,prim.p1,prim.p2,prim.p3,Occluded1Epilog1<true>(ray,context,prim.geomID(),prim.primID()));
@@ -104,7 +108,9 @@ namespace embree
       {
         STAT3(normal.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*)context->scene->get(prim.geomID());
-        if (likely(geom->subtype == BezierCurves::HAIR))
+        if (unlikely(geom->ribbon(Vec3fa(ray.org.x[k],ray.org.y[k],ray.org.z[k]),prim.p0)))
+          pre.intersectorHair.intersectRibbon(ray,k,prim.p0,prim.p1,prim.p2,prim.p3,Intersect1KEpilogMU<4,K,true>(ray,k,context,prim.geomID(),prim.primID()));
+        else if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,k,prim.p0,prim.p1,prim.p2,prim.p3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID()));
         else
           pre.intersectorCurve.intersect(ray,k,prim.p0,prim.p1,prim.p2,prim.p3,Intersect1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID()));
@@ -120,7 +126,9 @@ namespace embree
       {
         STAT3(shadow.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*)context->scene->get(prim.geomID());
-         if (likely(geom->subtype == BezierCurves::HAIR))
+         if (unlikely(geom->ribbon(Vec3fa(ray.org.x[k],ray.org.y[k],ray.org.z[k]),prim.p0)))
+           return pre.intersectorHair.intersectRibbon(ray,k,prim.p0,prim.p1,prim.p2,prim.p3,Occluded1KEpilogMU<4,K,true>(ray,k,context,prim.geomID(),prim.primID()));
+         else if (likely(geom->subtype == BezierCurves::HAIR))
            return pre.intersectorHair.intersect(ray,k,prim.p0,prim.p1,prim.p2,prim.p3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID()));
          else
            return pre.intersectorCurve.intersect(ray,k,prim.p0,prim.p1,prim.p2,prim.p3,Occluded1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID()));
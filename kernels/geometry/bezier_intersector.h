@@ -61,6 +61,33 @@ namespace embree
       vfloat<M> vt;
     };
     
+    /*! Intersects a curve transformed into ray space with 4 flat, ray
+     *  facing linear segments. Returns the hit mask and the segment
+     *  local u coordinate and hit distance of each segment. */
+    __forceinline vbool4 intersectRibbon4(const BezierCurve3fa& curve2D, const float depth_scale, const float ray_tnear, const float ray_tfar,
+                                          vfloat4& u_o, vfloat4& t_o)
+    {
+      /* evaluate the bezier curve */
+      vbool4 valid = true;
+      const Vec4vf4 p0 = curve2D.eval0(valid,0,4);
+      const Vec4vf4 p1 = curve2D.eval1(valid,0,4);
+
+      /* intersection with ray facing quads */
+      const Vec4vf4 v = p1-p0;
+      const Vec4vf4 w = -p0;
+      const vfloat4 d0 = w.x*v.x + w.y*v.y;
+      const vfloat4 d1 = v.x*v.x + v.y*v.y;
+      const vfloat4 u = clamp(d0*rcp(d1),vfloat4(zero),vfloat4(one));
+      const Vec4vf4 p = p0 + u*v;
+      const vfloat4 t = p.z*depth_scale;
+      const vfloat4 d2 = p.x*p.x + p.y*p.y;
+      const vfloat4 r = p.w;
+      const vfloat4 r2 = r*r;
+      valid &= (d2 <= r2) & (vfloat4(ray_tnear) < t) & (t < vfloat4(ray_tfar));
+      u_o = u; t_o = t;
+      return valid;
+    }
+
     struct Bezier1Intersector1
     {
       float depth_scale;
@@ -141,6 +168,29 @@ namespace embree
         }
         return ishit;
       }
+
+      /*! intersects the curve as a flat, ray facing ribbon made of 4 segments */
+      template<typename Epilog>
+      __forceinline bool intersectRibbon(Ray& ray,
+                                         const Vec3fa& v0, const Vec3fa& v1, const Vec3fa& v2, const Vec3fa& v3,
+                                         const Epilog& epilog) const
+      {
+        /* transform control points into ray space */
+        STAT3(normal.trav_prims,1,1,1);
+        Vec3fa w0 = xfmVector(ray_space,v0-ray.org); w0.w = v0.w;
+        Vec3fa w1 = xfmVector(ray_space,v1-ray.org); w1.w = v1.w;
+        Vec3fa w2 = xfmVector(ray_space,v2-ray.org); w2.w = v2.w;
+        Vec3fa w3 = xfmVector(ray_space,v3-ray.org); w3.w = v3.w;
+        BezierCurve3fa curve2D(w0,w1,w2,w3,0.0f,1.0f,4);
+
+        vfloat4 u, t;
+        const vbool4 valid = intersectRibbon4(curve2D,depth_scale,ray.tnear,ray.tfar,u,t);
+        if (likely(none(valid))) return false;
+
+        /* update hit information */
+        BezierHit<4> hit(valid,u,0.0f,t,0,4,v0,v1,v2,v3);
+        return epilog(valid,hit);
+      }
     };
 
     template<int K>
@@ -212,6 +262,29 @@ namespace embree
         }
         return ishit;
       }
+
+      /*! intersects the curve as a flat, ray facing ribbon made of 4 segments */
+      template<typename Epilog>
+      __forceinline bool intersectRibbon(RayK<K>& ray, size_t k,
+                                         const Vec3fa& v0, const Vec3fa& v1, const Vec3fa& v2, const Vec3fa& v3,
+                                         const Epilog& epilog) const
+      {
+        /* transform control points into ray space */
+        const Vec3fa ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        Vec3fa w0 = xfmVector(ray_space[k],v0-ray_org); w0.w = v0.w;
+        Vec3fa w1 = xfmVector(ray_space[k],v1-ray_org); w1.w = v1.w;
+        Vec3fa w2 = xfmVector(ray_space[k],v2-ray_org); w2.w = v2.w;
+        Vec3fa w3 = xfmVector(ray_space[k],v3-ray_org); w3.w = v3.w;
+        BezierCurve3fa curve2D(w0,w1,w2,w3,0.0f,1.0f,4);
+
+        vfloat4 u, t;
+        const vbool4 valid = intersectRibbon4(curve2D,depth_scale[k],ray.tnear[k],ray.tfar[k],u,t);
+        if (likely(none(valid))) return false;
+
+        /* update hit information */
+        BezierHit<4> hit(valid,u,0.0f,t,0,4,v0,v1,v2,v3);
+        return epilog(valid,hit);
+      }
     };
   }
 }
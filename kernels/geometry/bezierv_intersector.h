@@ -0,0 +1,206 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bezierv.h"
+#include "bezier1v_intersector.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Culls M curves against a ray in ray space. The control points
+     *  of all curves get transformed into the space of the ray in
+     *  parallel, and curves whose radius enlarged bounds do not contain
+     *  the ray or do not overlap the ray segment are rejected. Returns
+     *  a bitmask of the curves that need a precise intersection test. */
+    template<int M>
+      __forceinline size_t cullBezierMv(const BezierMv<M>& prim, const LinearSpace3fa& ray_space, const float depth_scale,
+                                        const Vec3fa& ray_org, const float ray_tnear, const float ray_tfar)
+    {
+      typedef Vec3<vfloat<M>> Vec3vfM;
+
+      auto xfm = [&] (const Vec4<vfloat<M>>& p) -> Vec3vfM {
+        const vfloat<M> x = p.x-vfloat<M>(ray_org.x);
+        const vfloat<M> y = p.y-vfloat<M>(ray_org.y);
+        const vfloat<M> z = p.z-vfloat<M>(ray_org.z);
+        return Vec3vfM(x*ray_space.vx.x + y*ray_space.vy.x + z*ray_space.vz.x,
+                       x*ray_space.vx.y + y*ray_space.vy.y + z*ray_space.vz.y,
+                       x*ray_space.vx.z + y*ray_space.vy.z + z*ray_space.vz.z);
+      };
+      const Vec3vfM w0 = xfm(prim.p0);
+      const Vec3vfM w1 = xfm(prim.p1);
+      const Vec3vfM w2 = xfm(prim.p2);
+      const Vec3vfM w3 = xfm(prim.p3);
+
+      /* the curves lie inside the convex hull of their control points enlarged by the maximal radius */
+      const vfloat<M> r = max(max(prim.p0.w,prim.p1.w),max(prim.p2.w,prim.p3.w));
+      const Vec3vfM lower = min(min(w0,w1),min(w2,w3)) - Vec3vfM(r);
+      const Vec3vfM upper = max(max(w0,w1),max(w2,w3)) + Vec3vfM(r);
+
+      vbool<M> valid = prim.valid();
+      valid &= (lower.x <= vfloat<M>(zero)) & (upper.x >= vfloat<M>(zero));
+      valid &= (lower.y <= vfloat<M>(zero)) & (upper.y >= vfloat<M>(zero));
+      valid &= (upper.z*depth_scale >= vfloat<M>(ray_tnear)) & (lower.z*depth_scale <= vfloat<M>(ray_tfar));
+      return movemask(valid);
+    }
+
+    /*! Intersector for a single ray with M bezier curves. */
+    template<int M>
+      struct BezierMvIntersector1
+    {
+      typedef BezierMv<M> Primitive;
+      typedef Bezier1vIntersector1::Precalculations Precalculations;
+
+      static __forceinline size_t cull(const Precalculations& pre, const Ray& ray, const Primitive& prim) {
+        return cullBezierMv(prim,pre.intersectorHair.ray_space,pre.intersectorHair.depth_scale,ray.org,ray.tnear,ray.tfar);
+      }
+
+      static __forceinline void intersect(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& prim)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        size_t mask = cull(pre,ray,prim);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const BezierCurves* geom = (BezierCurves*)context->scene->get(geomID);
+          if (unlikely(geom->ribbon(ray.org,prim.v0(i))))
+            pre.intersectorHair.intersectRibbon(ray,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),Intersect1EpilogMU<4,true>(ray,context,geomID,primID));
+          else if (likely(geom->subtype == BezierCurves::HAIR))
+            pre.intersectorHair.intersect(ray,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,geomID,primID));
+          else
+            pre.intersectorCurve.intersect(ray,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),Intersect1Epilog1<true>(ray,context,geomID,primID));
+        }
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& prim)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        size_t mask = cull(pre,ray,prim);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const BezierCurves* geom = (BezierCurves*)context->scene->get(geomID);
+          if (unlikely(geom->ribbon(ray.org,prim.v0(i)))) {
+            if (pre.intersectorHair.intersectRibbon(ray,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),Occluded1EpilogMU<4,true>(ray,context,geomID,primID)))
+              return true;
+          } else if (likely(geom->subtype == BezierCurves::HAIR)) {
+            if (pre.intersectorHair.intersect(ray,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,geomID,primID)))
+              return true;
+          } else {
+            if (pre.intersectorCurve.intersect(ray,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),Occluded1Epilog1<true>(ray,context,geomID,primID)))
+              return true;
+          }
+        }
+        return false;
+      }
+
+      /*! Intersect an array of rays with an array of M primitives. */
+      static __forceinline size_t intersect(Precalculations* pre, size_t valid, Ray** rays, IntersectContext* context,  size_t ty, const Primitive* prim, size_t num)
+      {
+        size_t valid_isec = 0;
+        do {
+          const size_t i = __bscf(valid);
+          const float old_far = rays[i]->tfar;
+          for (size_t n=0; n<num; n++)
+            intersect(pre[i],*rays[i],context,prim[n]);
+          valid_isec |= (rays[i]->tfar < old_far) ? ((size_t)1 << i) : 0;
+        } while(unlikely(valid));
+        return valid_isec;
+      }
+    };
+
+    /*! Intersector for a single ray from a ray packet with M bezier curves. */
+    template<int M, int K>
+      struct BezierMvIntersectorK
+    {
+      typedef BezierMv<M> Primitive;
+      typedef typename Bezier1vIntersectorK<K>::Precalculations Precalculations;
+
+      static __forceinline size_t cull(const Precalculations& pre, const RayK<K>& ray, const size_t k, const Primitive& prim)
+      {
+        const Vec3fa ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        return cullBezierMv(prim,pre.intersectorHair.ray_space[k],pre.intersectorHair.depth_scale[k],ray_org,ray.tnear[k],ray.tfar[k]);
+      }
+
+      static __forceinline void intersect(Precalculations& pre, RayK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        size_t mask = cull(pre,ray,k,prim);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const BezierCurves* geom = (BezierCurves*)context->scene->get(geomID);
+          if (unlikely(geom->ribbon(Vec3fa(ray.org.x[k],ray.org.y[k],ray.org.z[k]),prim.v0(i))))
+            pre.intersectorHair.intersectRibbon(ray,k,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),Intersect1KEpilogMU<4,K,true>(ray,k,context,geomID,primID));
+          else if (likely(geom->subtype == BezierCurves::HAIR))
+            pre.intersectorHair.intersect(ray,k,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,geomID,primID));
+          else
+            pre.intersectorCurve.intersect(ray,k,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),Intersect1KEpilog1<K,true>(ray,k,context,geomID,primID));
+        }
+      }
+
+      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& prim)
+      {
+        int mask = movemask(valid_i);
+        while (mask) intersect(pre,ray,__bscf(mask),context,prim);
+      }
+
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        size_t mask = cull(pre,ray,k,prim);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const BezierCurves* geom = (BezierCurves*)context->scene->get(geomID);
+          if (unlikely(geom->ribbon(Vec3fa(ray.org.x[k],ray.org.y[k],ray.org.z[k]),prim.v0(i)))) {
+            if (pre.intersectorHair.intersectRibbon(ray,k,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),Occluded1KEpilogMU<4,K,true>(ray,k,context,geomID,primID)))
+              return true;
+          } else if (likely(geom->subtype == BezierCurves::HAIR)) {
+            if (pre.intersectorHair.intersect(ray,k,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,geomID,primID)))
+              return true;
+          } else {
+            if (pre.intersectorCurve.intersect(ray,k,prim.v0(i),prim.v1(i),prim.v2(i),prim.v3(i),Occluded1KEpilog1<K,true>(ray,k,context,geomID,primID)))
+              return true;
+          }
+        }
+        return false;
+      }
+
+      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& prim)
+      {
+        vbool<K> valid_o = false;
+        int mask = movemask(valid_i);
+        while (mask) {
+          size_t k = __bscf(mask);
+          if (occluded(pre,ray,k,context,prim))
+            set(valid_o, k);
+        }
+        return valid_o;
+      }
+    };
+  }
+}
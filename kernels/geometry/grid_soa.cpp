@@ -22,7 +22,8 @@ namespace embree
   {  
     GridSOA::GridSOA(const SubdivPatch1Base* patches, unsigned time_steps, unsigned time_steps_global,
                      const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight,
-                     const SubdivMesh* const geom, const size_t bvhBytes, const size_t gridBytes, BBox3fa* bounds_o)
+                     const SubdivMesh* const geom, const size_t bvhBytes, const size_t gridBytes, BBox3fa* bounds_o,
+                     const GridBatch* batch, const size_t batchIndex)
       : time_steps_global(time_steps_global),time_steps(time_steps), width(x1-x0+1), height(y1-y0+1), dim_offset(width*height),
         geomID(patches->geom), primID(patches->prim), 
         bvhBytes(unsigned(bvhBytes)), gridOffset(max(1u,time_steps_global-1)*unsigned(bvhBytes)), gridBytes(unsigned(gridBytes)), rootOffset(unsigned(gridOffset+time_steps*gridBytes))
@@ -39,9 +40,12 @@ namespace embree
       /* first create the grids for each time step */
       for (size_t t=0; t<time_steps; t++)
       {
-        /* compute vertex grid (+displacement) */
-        evalGrid(patches[t],x0,x1,y0,y1,swidth,sheight,
-                 local_grid_x,local_grid_y,local_grid_z,local_grid_u,local_grid_v,geom);
+        /* compute vertex grid (+displacement), or copy it from an already evaluated batch of grids */
+        if (batch)
+          batch->get(batchIndex+t,x0,x1,y0,y1,local_grid_x,local_grid_y,local_grid_z,local_grid_u,local_grid_v);
+        else
+          evalGrid(patches[t],x0,x1,y0,y1,swidth,sheight,
+                   local_grid_x,local_grid_y,local_grid_z,local_grid_u,local_grid_v,geom);
         
         /* encode UVs */
         for (unsigned i=0; i<dim_offset; i+=VSIZEX) {
@@ -35,13 +35,15 @@ namespace embree
       /*! GridSOA constructor */
       GridSOA(const SubdivPatch1Base* patches, const unsigned time_steps, const unsigned time_steps_global,
               const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight,
-              const SubdivMesh* const geom, const size_t bvhBytes, const size_t gridBytes, BBox3fa* bounds_o = nullptr);
+              const SubdivMesh* const geom, const size_t bvhBytes, const size_t gridBytes, BBox3fa* bounds_o = nullptr,
+              const GridBatch* batch = nullptr, const size_t batchIndex = 0);
 
       /*! Subgrid creation */
       template<typename Allocator>
         static GridSOA* create(const SubdivPatch1Base* patches, const unsigned time_steps, const unsigned time_steps_global,
                                unsigned x0, unsigned x1, unsigned y0, unsigned y1, 
-                               const Scene* scene, Allocator& alloc, BBox3fa* bounds_o = nullptr)
+                               const Scene* scene, Allocator& alloc, BBox3fa* bounds_o = nullptr,
+                               const GridBatch* batch = nullptr, const size_t batchIndex = 0)
       {
         if (x1-x0 < 2 && x0 > 0) x0--;
         if (y1-y0 < 2 && y0 > 0) y0--;
@@ -54,15 +56,16 @@ namespace embree
         const size_t rootBytes = time_steps_global*sizeof(BVH4::NodeRef);
         void* data = alloc(offsetof(GridSOA,data)+max(1u,time_steps_global-1)*bvhBytes+time_steps*gridBytes+rootBytes);
         assert(data);
-        return new (data) GridSOA(patches,time_steps,time_steps_global,x0,x1,y0,y1,patches->grid_u_res,patches->grid_v_res,scene->getSubdivMesh(patches->geom),bvhBytes,gridBytes,bounds_o);
+        return new (data) GridSOA(patches,time_steps,time_steps_global,x0,x1,y0,y1,patches->grid_u_res,patches->grid_v_res,scene->getSubdivMesh(patches->geom),bvhBytes,gridBytes,bounds_o,batch,batchIndex);
       }
 
       /*! Grid creation */
       template<typename Allocator>
         static GridSOA* create(const SubdivPatch1Base* const patches, const unsigned time_steps, const unsigned time_steps_global,
-                               const Scene* scene, const Allocator& alloc, BBox3fa* bounds_o = nullptr) 
+                               const Scene* scene, const Allocator& alloc, BBox3fa* bounds_o = nullptr,
+                               const GridBatch* batch = nullptr, const size_t batchIndex = 0) 
       {
-        return create(patches,time_steps,time_steps_global,0,patches->grid_u_res-1,0,patches->grid_v_res-1,scene,alloc,bounds_o);
+        return create(patches,time_steps,time_steps_global,0,patches->grid_u_res-1,0,patches->grid_v_res-1,scene,alloc,bounds_o,batch,batchIndex);
       }
 
        /*! returns reference to root */
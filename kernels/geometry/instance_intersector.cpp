@@ -39,23 +39,41 @@ namespace embree
     template<> __forceinline void occludedObject <16>(vint16* valid, Scene* object, IntersectContext* context, Ray16& ray) { object->occluded16 (valid,(RTCRay16&)ray,context); }
 #endif
 
+    /* transforms the active rays of the packet one by one, used for double precision instances */
+    template<int K>
+    __forceinline void xfmRayK(const vbool<K>& valid, const Instance* instance, RayK<K>& ray)
+    {
+      for (size_t k=0; k<K; k++) 
+      {
+        if (!valid[k]) continue;
+        Vec3fa org, dir;
+        instance->xfmRay(Vec3fa(ray.org.x[k],ray.org.y[k],ray.org.z[k]),Vec3fa(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]),ray.time[k],org,dir);
+        ray.org.x[k] = org.x; ray.org.y[k] = org.y; ray.org.z[k] = org.z;
+        ray.dir.x[k] = dir.x; ray.dir.y[k] = dir.y; ray.dir.z[k] = dir.z;
+      }
+    }
+
     template<int K>
     void FastInstanceIntersectorK<K>::intersect(vint<K>* validi, const Instance* instance, RayK<K>& ray, size_t item)
     {
       typedef Vec3<vfloat<K>> Vec3vfK;
       typedef AffineSpaceT<LinearSpace3<Vec3vfK>> AffineSpace3vfK;
       
-      AffineSpace3vfK world2local;
       const vbool<K> valid = *validi == vint<K>(-1);
-      if (likely(instance->numTimeSteps == 1)) world2local = instance->getWorld2Local();
-      else                                     world2local = instance->getWorld2Local<K>(valid,ray.time);
-
       const Vec3vfK ray_org = ray.org;
       const Vec3vfK ray_dir = ray.dir;
       const vint<K> ray_geomID = ray.geomID;
       const vint<K> ray_instID = ray.instID;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
+      if (likely(!instance->precise))
+      {
+        AffineSpace3vfK world2local;
+        if (likely(instance->numTimeSteps == 1)) world2local = instance->getWorld2Local();
+        else                                     world2local = instance->getWorld2Local<K>(valid,ray.time);
+        ray.org = xfmPoint (world2local,ray_org);
+        ray.dir = xfmVector(world2local,ray_dir);
+      }
+      else
+        xfmRayK(valid,instance,ray);
       ray.geomID = RTC_INVALID_GEOMETRY_ID;
       ray.instID = instance->id;
       IntersectContext context(instance->object,nullptr); 
@@ -73,18 +91,26 @@ namespace embree
       typedef Vec3<vfloat<K>> Vec3vfK;
       typedef AffineSpaceT<LinearSpace3<Vec3vfK>> AffineSpace3vfK;
 
-      AffineSpace3vfK world2local;
-      const vbool<K> valid = *validi == vint<K>(-1);
-      if (likely(instance->numTimeSteps == 1)) world2local = instance->getWorld2Local();
-      else                                     world2local = instance->getWorld2Local<K>(valid,ray.time);
+      /* only trace rays that did not get occluded yet */
+      const vbool<K> valid = (*validi == vint<K>(-1)) & (ray.geomID != 0);
+      if (unlikely(none(valid))) return;
+      vint<K> validt = select(valid,vint<K>(-1),vint<K>(0));
 
       const Vec3vfK ray_org = ray.org;
       const Vec3vfK ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
+      if (likely(!instance->precise))
+      {
+        AffineSpace3vfK world2local;
+        if (likely(instance->numTimeSteps == 1)) world2local = instance->getWorld2Local();
+        else                                     world2local = instance->getWorld2Local<K>(valid,ray.time);
+        ray.org = xfmPoint (world2local,ray_org);
+        ray.dir = xfmVector(world2local,ray_dir);
+      }
+      else
+        xfmRayK(valid,instance,ray);
       ray.instID = instance->id;
       IntersectContext context(instance->object,nullptr);
-      occludedObject(validi,instance->object,&context,ray);
+      occludedObject(&validt,instance->object,&context,ray);
       ray.org = ray_org;
       ray.dir = ray_dir;
     }
@@ -25,28 +25,40 @@ namespace embree
     {
       assert(itime < instance->numTimeSteps);
       unsigned num_time_segments = instance->numTimeSegments();
-      if (num_time_segments == 0) {
-        bounds_o = xfmBounds(instance->local2world[itime],instance->object->bounds.bounds());
-      }
-      else {
+      BBox3fa obounds = instance->object->bounds.bounds();
+      if (num_time_segments != 0) {
         const float ftime = float(itime) / float(num_time_segments);
-        const BBox3fa obounds = instance->object->bounds.interpolate(ftime);
+        obounds = instance->object->bounds.interpolate(ftime);
+      }
+
+      if (likely(!instance->precise)) {
         bounds_o = xfmBounds(instance->local2world[itime],obounds);
+        return;
+      }
+
+      /* transform bounds in double precision and round conservatively */
+      const AffineSpace3d& xfm = instance->local2worldd[itime];
+      BBox<Vec3d> bounds = empty;
+      for (size_t i=0; i<8; i++) {
+        const Vec3d p((i&1) ? obounds.upper.x : obounds.lower.x,
+                      (i&2) ? obounds.upper.y : obounds.lower.y,
+                      (i&4) ? obounds.upper.z : obounds.lower.z);
+        bounds.extend(xfmPoint(xfm,p));
       }
+      const Vec3fa lower(nextafter(float(bounds.lower.x),-FLT_MAX),nextafter(float(bounds.lower.y),-FLT_MAX),nextafter(float(bounds.lower.z),-FLT_MAX));
+      const Vec3fa upper(nextafter(float(bounds.upper.x),+FLT_MAX),nextafter(float(bounds.upper.y),+FLT_MAX),nextafter(float(bounds.upper.z),+FLT_MAX));
+      bounds_o = BBox3fa(lower,upper);
     }
 
     RTCBoundsFunc3 InstanceBoundsFunc = (RTCBoundsFunc3) InstanceBoundsFunction;
 
     void FastInstanceIntersector1::intersect(const Instance* instance, Ray& ray, size_t item)
     {
-      const AffineSpace3fa world2local = 
-        likely(instance->numTimeSteps == 1) ? instance->getWorld2Local() : instance->getWorld2Local(ray.time);
       const Vec3fa ray_org = ray.org;
       const Vec3fa ray_dir = ray.dir;
       const int ray_geomID = ray.geomID;
       const int ray_instID = ray.instID;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
+      instance->xfmRay(ray_org,ray_dir,ray.time,ray.org,ray.dir);
       ray.geomID = RTC_INVALID_GEOMETRY_ID;
       ray.instID = instance->id;
       IntersectContext context(instance->object,nullptr);
@@ -61,12 +73,12 @@ namespace embree
     
     void FastInstanceIntersector1::occluded (const Instance* instance, Ray& ray, size_t item)
     {
-      const AffineSpace3fa world2local = 
-        likely(instance->numTimeSteps == 1) ? instance->getWorld2Local() : instance->getWorld2Local(ray.time);
+      /* ray got already occluded at some other instancing level */
+      if (unlikely(ray.geomID == 0)) return;
+
       const Vec3fa ray_org = ray.org;
       const Vec3fa ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
+      instance->xfmRay(ray_org,ray_dir,ray.time,ray.org,ray.dir);
       ray.instID = instance->id;
       IntersectContext context(instance->object,nullptr);
       instance->object->occluded((RTCRay&)ray,&context);
@@ -80,15 +92,10 @@ namespace embree
     {
       assert(M<=MAX_INTERNAL_STREAM_SIZE);
       Ray lrays[MAX_INTERNAL_STREAM_SIZE];
-      AffineSpace3fa world2local = instance->getWorld2Local();
 
       for (size_t i=0; i<M; i++)
       {
-        if (unlikely(instance->numTimeSteps != 1)) 
-          world2local = instance->getWorld2Local(rays[i]->time);
-
-        lrays[i].org = xfmPoint (world2local,rays[i]->org);
-        lrays[i].dir = xfmVector(world2local,rays[i]->dir);
+        instance->xfmRay(rays[i]->org,rays[i]->dir,rays[i]->time,lrays[i].org,lrays[i].dir);
         lrays[i].tnear = rays[i]->tnear;
         lrays[i].tfar = rays[i]->tfar;
         lrays[i].time = rays[i]->time;
@@ -114,31 +121,33 @@ namespace embree
     
     void FastInstanceIntersector1M::occluded (const Instance* instance, RTCIntersectContext* context, Ray** rays, size_t M, size_t item)
     {
-      assert(M<MAX_INTERNAL_STREAM_SIZE);
+      assert(M<=MAX_INTERNAL_STREAM_SIZE);
       Ray lrays[MAX_INTERNAL_STREAM_SIZE];
-      AffineSpace3fa world2local = instance->getWorld2Local();
+      size_t index[MAX_INTERNAL_STREAM_SIZE];
       
+      /* only trace rays that did not get occluded yet */
+      size_t N = 0;
       for (size_t i=0; i<M; i++)
       {
-        if (unlikely(instance->numTimeSteps != 1)) 
-          world2local = instance->getWorld2Local(rays[i]->time);
+        if (unlikely(rays[i]->geomID == 0)) continue;
 
-        lrays[i].org = xfmPoint (world2local,rays[i]->org);
-        lrays[i].dir = xfmVector(world2local,rays[i]->dir);
-        lrays[i].tnear = rays[i]->tnear;
-        lrays[i].tfar = rays[i]->tfar;
-        lrays[i].time = rays[i]->time;
-        lrays[i].mask = rays[i]->mask;
-        lrays[i].geomID = RTC_INVALID_GEOMETRY_ID;
-        lrays[i].instID = instance->id;
+        instance->xfmRay(rays[i]->org,rays[i]->dir,rays[i]->time,lrays[N].org,lrays[N].dir);
+        lrays[N].tnear = rays[i]->tnear;
+        lrays[N].tfar = rays[i]->tfar;
+        lrays[N].time = rays[i]->time;
+        lrays[N].mask = rays[i]->mask;
+        lrays[N].geomID = RTC_INVALID_GEOMETRY_ID;
+        lrays[N].instID = instance->id;
+        index[N++] = i;
       }
+      if (unlikely(N == 0)) return;
 
-      rtcOccluded1M((RTCScene)instance->object,context,(RTCRay*)lrays,M,sizeof(Ray));
+      rtcOccluded1M((RTCScene)instance->object,context,(RTCRay*)lrays,N,sizeof(Ray));
         
-      for (size_t i=0; i<M; i++)
+      for (size_t i=0; i<N; i++)
       {
         if (lrays[i].geomID == RTC_INVALID_GEOMETRY_ID) continue;
-        rays[i]->geomID = 0;
+        rays[index[i]]->geomID = 0;
       }
     }
 
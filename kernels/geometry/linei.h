@@ -116,6 +116,16 @@ namespace embree
       return allBounds;
     }
 
+    __forceinline LBBox3fa linearBounds(const Scene *const scene, const BBox1f& time_range) {
+      LBBox3fa allBounds = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+      {
+        const LineSegments* geom = scene->getLineSegments(geomID(i));
+        allBounds.extend(geom->linearBounds(primID(i), time_range));
+      }
+      return allBounds;
+    }
+
     /* Fill line segment from line segment list */
     __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
     {
@@ -152,6 +162,13 @@ namespace embree
       return linearBounds(scene,itime,numTimeSteps);
     }
 
+    /* Fill line segment from line segment list and calculate the linear bounds for the specified time range */
+    __forceinline LBBox3fa fillMB(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range)
+    {
+      fill(prims,begin,end,scene,list);
+      return linearBounds(scene,time_range);
+    }
+
     /* Updates the primitive */
     __forceinline BBox3fa update(LineSegments* geom)
     {
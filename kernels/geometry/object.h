@@ -61,6 +61,17 @@ namespace embree
       return accel->linearBounds(primID,itime,numTimeSteps);
     }
 
+    /*! fill triangle from triangle list and calculate the linear bounds for the specified time range */
+    __forceinline LBBox3fa fillMB(const PrimRef* prims, size_t& i, size_t end, Scene* scene, const bool list, const BBox1f& time_range)
+    {
+      const PrimRef& prim = prims[i]; i++;
+      const unsigned geomID = prim.geomID();
+      const unsigned primID = prim.primID();
+      new (this) Object(geomID, primID);
+      AccelSet* accel = (AccelSet*) scene->get(geomID);
+      return accel->linearBounds(primID,time_range);
+    }
+
     /* Updates the primitive */
     __forceinline BBox3fa update(AccelSet* mesh) {
       return mesh->bounds(primID);
@@ -194,7 +194,9 @@ namespace embree
 
       static __forceinline vbool<K> occluded(const vbool<K>& valid_i, const Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& prim)
       {
-        vbool<K> valid = valid_i;
+        /* skip rays that got already occluded */
+        vbool<K> valid = valid_i & (ray.geomID != 0);
+        if (none(valid)) return ray.geomID == 0;
         AccelSet* accel = (AccelSet*) context->scene->get(prim.geomID);
         
         /* perform ray mask test */
@@ -17,10 +17,12 @@
 #include "primitive.h"
 #include "bezier1v.h"
 #include "bezier1i.h"
+#include "bezierv.h"
 #include "linei.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglei.h"
+#include "trianglem.h"
 #include "trianglev_mb.h"
 #include "trianglei_mb.h"
 #include "quadv.h"
@@ -53,6 +55,17 @@ namespace embree
 
   Bezier1i::Type Bezier1i::type;
 
+  /********************** Bezier4v **************************/
+
+  template<>
+  Bezier4v::Type::Type ()
+    : PrimitiveType("bezier4v",sizeof(Bezier4v),4) {}
+
+  template<>
+  size_t Bezier4v::Type::size(const char* This) const {
+    return ((Bezier4v*)This)->size();
+  }
+
   /********************** Line4i **************************/
 
   template<>
@@ -97,6 +110,17 @@ namespace embree
     return ((Triangle4i*)This)->size();
   }
 
+  /********************** Triangle4m **************************/
+
+  template<>
+  Triangle4m::Type::Type () 
+    : PrimitiveType("triangle4m",sizeof(Triangle4m),4) {} 
+
+  template<>
+  size_t Triangle4m::Type::size(const char* This) const {
+    return ((Triangle4m*)This)->size();
+  }
+
   /********************** Triangle4vMB **************************/
 
   template<>
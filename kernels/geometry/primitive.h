@@ -65,6 +65,13 @@ namespace embree
 
     __forceinline unsigned numTimeSteps() const { return numTimeSteps_; }
 
+    /* calculates the time segment for non-uniformly distributed time steps */
+    __forceinline void setTimeSegment(const float time, const float* timeSteps, unsigned numTimeSteps)
+    {
+      itime_ = int(std::upper_bound(timeSteps+1,timeSteps+numTimeSteps-1,time)-(timeSteps+1));
+      ftime_ = (time-timeSteps[itime_])/(timeSteps[itime_+1]-timeSteps[itime_]);
+    }
+
   private:
     /* used for msmblur implementation */
     int itime_;
@@ -107,6 +114,23 @@ namespace embree
 
     __forceinline unsigned numTimeSteps() const { return numTimeSteps_; }
 
+    /* calculates the time segments for non-uniformly distributed time steps */
+    __forceinline void setTimeSegment(const vfloat<K>& time, const float* timeSteps, unsigned numTimeSteps)
+    {
+      vint<K> itime = zero;
+      vfloat<K> time0 = timeSteps[0];
+      vfloat<K> time1 = timeSteps[numTimeSteps-1];
+      for (size_t i=1; i<numTimeSteps-1; i++)
+      {
+        const vbool<K> after = time >= vfloat<K>(timeSteps[i]);
+        itime = select(after,itime+1,itime);
+        time0 = select(after,vfloat<K>(timeSteps[i]),time0);
+        time1 = select(after,time1,min(time1,vfloat<K>(timeSteps[i])));
+      }
+      itime_ = itime;
+      ftime_ = (time-time0)/(time1-time0);
+    }
+
   private:
     /* used for msmblur implementation */
     vint<K> itime_;
@@ -109,11 +109,24 @@ namespace embree
       vfloat<K> ftime;
       const vint<K> itime = getTimeSegment(time, vfloat<K>(mesh->fnumTimeSegments), ftime);
 
-      const size_t first = __bsf(movemask(valid)); // assume itime is uniform
+      const size_t first = __bsf(movemask(valid));
       p0 = getVertex(v0, index, scene, itime[first], ftime);
       p1 = getVertex(v1, index, scene, itime[first], ftime);
       p2 = getVertex(v2, index, scene, itime[first], ftime);
       p3 = getVertex(v3, index, scene, itime[first], ftime);
+
+      /* rays of the packet may lie in different time segments of the mesh */
+      vbool<K> valid_t = valid & (itime != vint<K>(itime[first]));
+      while (unlikely(any(valid_t)))
+      {
+        const size_t itime_t = itime[__bsf(movemask(valid_t))];
+        const vbool<K> m = valid_t & (itime == vint<K>(int(itime_t)));
+        p0 = select(m, getVertex(v0, index, scene, itime_t, ftime), p0);
+        p1 = select(m, getVertex(v1, index, scene, itime_t, ftime), p1);
+        p2 = select(m, getVertex(v2, index, scene, itime_t, ftime), p2);
+        p3 = select(m, getVertex(v3, index, scene, itime_t, ftime), p3);
+        valid_t &= !m;
+      }
     }
 
     __forceinline void gather(Vec3<vfloat<M>>& p0, 
@@ -166,9 +179,19 @@ namespace embree
       }
       return allBounds;
     }
+
+    __forceinline LBBox3fa linearBounds(const Scene *const scene, const BBox1f& time_range) {
+      LBBox3fa allBounds = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+      {
+        const QuadMesh* mesh = scene->getQuadMesh(geomID(i));
+        allBounds.extend(mesh->linearBounds(primID(i), time_range));
+      }
+      return allBounds;
+    }
     
     /* Fill quad from quad list */
-    __forceinline LBBox3fa fillMB(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, size_t itime, size_t numTimeSteps)
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
     {
       vint<M> geomID = -1, primID = -1;
       vint<M> v0 = zero, v1 = zero, v2 = zero, v3 = zero;
@@ -199,9 +222,22 @@ namespace embree
       }
       
       new (this) QuadMiMB(v0,v1,v2,v3,geomID,primID); // FIXME: use non temporal store
+    }
+
+    /* Fill quad from quad list and calculate the linear bounds for the itime'th time segment */
+    __forceinline LBBox3fa fillMB(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, size_t itime, size_t numTimeSteps)
+    {
+      fill(prims,begin,end,scene,list);
       return linearBounds(scene,itime,numTimeSteps);
     }
 
+    /* Fill quad from quad list and calculate the linear bounds for the specified time range */
+    __forceinline LBBox3fa fillMB(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range)
+    {
+      fill(prims,begin,end,scene,list);
+      return linearBounds(scene,time_range);
+    }
+
     friend std::ostream& operator<<(std::ostream& cout, const QuadMiMB& quad) {
       return cout << "QuadMiMB<" << M << ">( v0 = " << quad.v0 << ", v1 = " << quad.v1 << ", v2 = " << quad.v2 << ", v3 = " << quad.v3 << ", geomID = " << quad.geomIDs << ", primID = " << quad.primIDs << " )";
     }
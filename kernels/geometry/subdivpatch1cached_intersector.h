@@ -49,6 +49,29 @@ namespace embree
       }
     };
 
+    /*! Builds the grids of the patches following a missing patch in
+     *  the patch array. These are mostly neighbouring patches of the
+     *  same mesh, which following rays are likely to hit. */
+    static __forceinline void prefetchGrids(const SubdivPatch1Cached* prim, Scene* scene)
+    {
+      const size_t N = scene->device->tessellation_cache_prefetch;
+      if (likely(N == 0)) return;
+      if (SharedLazyTessellationCache::validTag(prim->root_ref,scene->commitCounterSubdiv)) return;
+
+      for (size_t i=0; i<N && !(prim->flags & SubdivPatch1Base::LAST_PATCH); i++)
+      {
+        SubdivPatch1Cached* next = (SubdivPatch1Cached*) (prim+1);
+        if (next->geom != prim->geom) break;
+        prim = next;
+        if (SharedLazyTessellationCache::validTag(next->root_ref,scene->commitCounterSubdiv)) continue;
+        SharedLazyTessellationCache::lookup(next->entry(),scene->commitCounterSubdiv,[&] () {
+            auto alloc = [] (const size_t bytes) { return SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(bytes); };
+            return GridSOA::create((SubdivPatch1Base*)next,1,1,scene,alloc);
+          });
+        SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+      }
+    }
+
     template<bool cached>
       class SubdivPatch1CachedIntersector1
     {
@@ -64,6 +87,7 @@ namespace embree
         {          
           Scene* scene = context->scene;
           if (pre.grid) SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+          prefetchGrids(prim,scene);
           grid = (GridSOA*) SharedLazyTessellationCache::lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
               auto alloc = [] (const size_t bytes) { return SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(bytes); };
               return GridSOA::create((SubdivPatch1Base*)prim,1,1,scene,alloc);
@@ -161,6 +185,7 @@ namespace embree
         {
           Scene* scene = context->scene;
           if (pre.grid) SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+          prefetchGrids(prim,scene);
           grid = (GridSOA*) SharedLazyTessellationCache::lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
               auto alloc = [] (const size_t bytes) { return SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(bytes); };
               return GridSOA::create((SubdivPatch1Base*)prim,1,1,scene,alloc);
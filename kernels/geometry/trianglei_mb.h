@@ -107,10 +107,22 @@ namespace embree
       vfloat<K> ftime;
       const vint<K> itime = getTimeSegment(time, vfloat<K>(mesh->fnumTimeSegments), ftime);
 
-      const size_t first = __bsf(movemask(valid)); // assume itime is uniform
+      const size_t first = __bsf(movemask(valid));
       p0 = getVertex(v0, index, scene, itime[first], ftime);
       p1 = getVertex(v1, index, scene, itime[first], ftime);
       p2 = getVertex(v2, index, scene, itime[first], ftime);
+
+      /* rays of the packet may lie in different time segments of the mesh */
+      vbool<K> valid_t = valid & (itime != vint<K>(itime[first]));
+      while (unlikely(any(valid_t)))
+      {
+        const size_t itime_t = itime[__bsf(movemask(valid_t))];
+        const vbool<K> m = valid_t & (itime == vint<K>(int(itime_t)));
+        p0 = select(m, getVertex(v0, index, scene, itime_t, ftime), p0);
+        p1 = select(m, getVertex(v1, index, scene, itime_t, ftime), p1);
+        p2 = select(m, getVertex(v2, index, scene, itime_t, ftime), p2);
+        valid_t &= !m;
+      }
     }
 
     __forceinline void gather(Vec3<vfloat<M>>& p0,
@@ -160,8 +172,18 @@ namespace embree
       return allBounds;
     }
 
+    __forceinline LBBox3fa linearBounds(const Scene *const scene, const BBox1f& time_range) {
+      LBBox3fa allBounds = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+      {
+        const TriangleMesh* mesh = scene->getTriangleMesh(geomID(i));
+        allBounds.extend(mesh->linearBounds(primID(i), time_range));
+      }
+      return allBounds;
+    }
+
     /* Fill triangle from triangle list */
-    __forceinline LBBox3fa fillMB(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, size_t itime, size_t numTimeSteps)
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
     {
       vint<M> geomID = -1, primID = -1;
       vint<M> v0 = zero, v1 = zero, v2 = zero;
@@ -190,9 +212,22 @@ namespace embree
       }
 
       new (this) TriangleMiMB(v0,v1,v2,geomID,primID); // FIXME: use non temporal store
+    }
+
+    /* Fill triangle from triangle list and calculate the linear bounds for the itime'th time segment */
+    __forceinline LBBox3fa fillMB(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, size_t itime, size_t numTimeSteps)
+    {
+      fill(prims,begin,end,scene,list);
       return linearBounds(scene,itime,numTimeSteps);
     }
 
+    /* Fill triangle from triangle list and calculate the linear bounds for the specified time range */
+    __forceinline LBBox3fa fillMB(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range)
+    {
+      fill(prims,begin,end,scene,list);
+      return linearBounds(scene,time_range);
+    }
+
     /* Updates the primitive */
     __forceinline BBox3fa update(TriangleMesh* mesh)
     {
@@ -0,0 +1,220 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Stores up to M triangles of one mesh as a meshlet, i.e. a small
+   * palette of shared vertices plus 8 bit local vertex indices per
+   * triangle. Vertices are stored at full precision, thus neighboring
+   * meshlets stay watertight. */
+  template <int M>
+  struct TriangleMm
+  {
+    typedef Vec3<vfloat<M>> Vec3vfM;
+
+    /* Virtual interface to query information about the triangle type */
+    struct Type : public PrimitiveType
+    {
+      Type();
+      size_t size(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Maximal number of vertices stored in the palette */
+    static const size_t maxVertices = 3*M/2;
+
+    /* Returns maximal number of stored triangles */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives,
+     * this is only an lower bound as the palette can get full */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+    /* Returns the number of primitive blocks fill requires for the specified primitives */
+    static __forceinline size_t blocks(const PrimRef* prims, size_t begin, size_t end, Scene* scene)
+    {
+      size_t items = 0;
+      while (begin < end) {
+        unsigned char v0[M], v1[M], v2[M]; unsigned vtx[maxVertices];
+        gatherMeshlet(prims,begin,end,scene,v0,v1,v2,vtx);
+        items++;
+      }
+      return items;
+    }
+
+  private:
+
+    /* adds the vertex with the specified index to the palette, returns false if the palette is full */
+    static __forceinline bool addVertex(unsigned* vtx, size_t& numVertices, const unsigned index, unsigned char& local)
+    {
+      for (size_t i=0; i<numVertices; i++) {
+        if (vtx[i] == index) { local = (unsigned char) i; return true; }
+      }
+      if (numVertices == maxVertices) return false;
+      local = (unsigned char) numVertices;
+      vtx[numVertices++] = index;
+      return true;
+    }
+
+    /* greedily collects triangles of the same mesh until the triangle or vertex palette is full */
+    static __forceinline size_t gatherMeshlet(const PrimRef* prims, size_t& begin, size_t end, Scene* scene,
+                                              unsigned char* v0, unsigned char* v1, unsigned char* v2, unsigned* vtx)
+    {
+      size_t numTriangles = 0, numVertices = 0;
+      const unsigned geomID = prims[begin].geomID();
+      const TriangleMesh* mesh = scene->getTriangleMesh(geomID);
+
+      for (; numTriangles<M && begin<end; numTriangles++, begin++)
+      {
+        const PrimRef& prim = prims[begin];
+        if (prim.geomID() != geomID) break;
+        const TriangleMesh::Triangle& tri = mesh->triangle(prim.primID());
+        const size_t numVertices0 = numVertices;
+        if (!addVertex(vtx,numVertices,tri.v[0],v0[numTriangles]) ||
+            !addVertex(vtx,numVertices,tri.v[1],v1[numTriangles]) ||
+            !addVertex(vtx,numVertices,tri.v[2],v2[numTriangles])) {
+          numVertices = numVertices0;
+          break;
+        }
+      }
+      assert(numTriangles);
+      return numTriangles;
+    }
+
+  public:
+
+    /* Default constructor */
+    __forceinline TriangleMm() {}
+
+    /* Returns a mask that tells which triangles are valid */
+    __forceinline vbool<M> valid() const { return primIDs != vint<M>(-1); }
+
+    /* Returns if the specified triangle is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return primIDs[i] != -1; }
+
+    /* Returns the number of stored triangles */
+    __forceinline size_t size() const { return __bsf(~movemask(valid())); }
+
+    /* Returns the geometry IDs */
+    __forceinline vint<M> geomID() const { return vint<M>(int(geomId)); }
+    __forceinline int geomID(const size_t i) const { assert(i<M); return geomId; }
+
+    /* Returns the primitive IDs */
+    __forceinline vint<M> primID() const { return primIDs; }
+    __forceinline int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* Returns the vertices of the i'th triangle */
+    __forceinline const Vec3f& vertex0(const size_t i) const { assert(i<M); return vertices[v0[i]]; }
+    __forceinline const Vec3f& vertex1(const size_t i) const { assert(i<M); return vertices[v1[i]]; }
+    __forceinline const Vec3f& vertex2(const size_t i) const { assert(i<M); return vertices[v2[i]]; }
+
+    /* gather the triangles */
+    __forceinline void gather(Vec3<vfloat<M>>& p0, Vec3<vfloat<M>>& p1, Vec3<vfloat<M>>& p2) const;
+
+    /* Calculate the bounds of the triangles */
+    __forceinline const BBox3fa bounds() const
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+      {
+        const Vec3f& p0 = vertex0(i);
+        const Vec3f& p1 = vertex1(i);
+        const Vec3f& p2 = vertex2(i);
+        bounds.extend(Vec3fa(p0.x,p0.y,p0.z));
+        bounds.extend(Vec3fa(p1.x,p1.y,p1.z));
+        bounds.extend(Vec3fa(p2.x,p2.y,p2.z));
+      }
+      return bounds;
+    }
+
+    /* Fill triangle from triangle list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    {
+      unsigned vtx[maxVertices];
+      const unsigned geomID = prims[begin].geomID();
+      const size_t first = begin;
+      const size_t numTriangles = gatherMeshlet(prims,begin,end,scene,v0,v1,v2,vtx);
+      const TriangleMesh* mesh = scene->getTriangleMesh(geomID);
+
+      for (size_t i=0; i<M; i++)
+      {
+        if (i < numTriangles) {
+          primIDs[i] = prims[first+i].primID();
+          const TriangleMesh::Triangle& tri = mesh->triangle(primIDs[i]);
+          vertices[v0[i]] = mesh->vertex(tri.v[0]);
+          vertices[v1[i]] = mesh->vertex(tri.v[1]);
+          vertices[v2[i]] = mesh->vertex(tri.v[2]);
+        } else {
+          primIDs[i] = -1;
+          v0[i] = v1[i] = v2[i] = v0[0];
+        }
+      }
+      geomId = geomID;
+    }
+
+    /* Updates the primitive */
+    __forceinline BBox3fa update(TriangleMesh* mesh)
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<M; i++)
+      {
+        if (primID(i) == -1) break;
+        const unsigned primId = primID(i);
+        const TriangleMesh::Triangle& tri = mesh->triangle(primId);
+        const Vec3fa p0 = mesh->vertex(tri.v[0]);
+        const Vec3fa p1 = mesh->vertex(tri.v[1]);
+        const Vec3fa p2 = mesh->vertex(tri.v[2]);
+        vertices[v0[i]] = p0;
+        vertices[v1[i]] = p1;
+        vertices[v2[i]] = p2;
+        bounds.extend(merge(BBox3fa(p0),BBox3fa(p1),BBox3fa(p2)));
+      }
+      return bounds;
+    }
+
+  public:
+    vint<M> primIDs;                // primitive ID of primitive inside mesh
+    Vec3f vertices[maxVertices];    // vertex palette of the meshlet
+    unsigned char v0[M];            // palette index of 1st vertex
+    unsigned char v1[M];            // palette index of 2nd vertex
+    unsigned char v2[M];            // palette index of 3rd vertex
+    unsigned geomId;                // geometry ID of mesh
+  };
+
+  template<>
+    __forceinline void TriangleMm<4>::gather(Vec3vf4& p0, Vec3vf4& p1, Vec3vf4& p2) const
+  {
+    /* the unaligned loads of the last palette vertex read into the index array, which is ignored by the transpose */
+    const float* base = (const float*) vertices;
+    const vfloat4 a0 = vfloat4::loadu(base+3*v0[0]), a1 = vfloat4::loadu(base+3*v0[1]), a2 = vfloat4::loadu(base+3*v0[2]), a3 = vfloat4::loadu(base+3*v0[3]);
+    const vfloat4 b0 = vfloat4::loadu(base+3*v1[0]), b1 = vfloat4::loadu(base+3*v1[1]), b2 = vfloat4::loadu(base+3*v1[2]), b3 = vfloat4::loadu(base+3*v1[3]);
+    const vfloat4 c0 = vfloat4::loadu(base+3*v2[0]), c1 = vfloat4::loadu(base+3*v2[1]), c2 = vfloat4::loadu(base+3*v2[2]), c3 = vfloat4::loadu(base+3*v2[3]);
+    transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
+    transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
+    transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
+  }
+
+  template<int M>
+  typename TriangleMm<M>::Type TriangleMm<M>::type;
+
+  typedef TriangleMm<4> Triangle4m;
+}
@@ -149,7 +149,14 @@ namespace embree
       new (this) TriangleMvMB(va0,va1,vb0,vb1,vc0,vc1,vgeomID,vprimID);
       return LBBox3fa(bounds0,bounds1);
     }
-   
+
+    /* Fill triangle from triangle list, the vertices are stored per time segment thus time splitting is not supported */
+    __forceinline LBBox3fa fillMB(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range)
+    {
+      throw_RTCError(RTC_INVALID_OPERATION, "TriangleMvMB is not supported for different number of time steps per mesh");
+      return empty;
+    }
+
   public:
     Vec3vfM v0;      // 1st vertex of the triangles
     Vec3vfM v1;      // 2nd vertex of the triangles
@@ -389,7 +389,7 @@ namespace embree
     }
 
     template<class T>
-      static __forceinline Vec3<T> normal(const Vertex matrix[4][4], const T& uu, const T& vv) 
+      static __forceinline void tangents(const Vertex matrix[4][4], const T& uu, const T& vv, Vec3<T>& tangentU, Vec3<T>& tangentV) 
     {
       
       const Vec3<T> matrix_00 = Vec3<T>(matrix[0][0].x,matrix[0][0].y,matrix[0][0].z);
@@ -418,7 +418,7 @@ namespace embree
       const Vec3<T> col2 = deCasteljau(vv, matrix_02, matrix_12, matrix_22, matrix_32);
       const Vec3<T> col3 = deCasteljau(vv, matrix_03, matrix_13, matrix_23, matrix_33);
       
-      const Vec3<T> tangentU = deCasteljau_tangent(uu, col0, col1, col2, col3);
+      tangentU = deCasteljau_tangent(uu, col0, col1, col2, col3);
       
       /* tangentV */
       const Vec3<T> row0 = deCasteljau(uu, matrix_00, matrix_01, matrix_02, matrix_03);
@@ -426,17 +426,27 @@ namespace embree
       const Vec3<T> row2 = deCasteljau(uu, matrix_20, matrix_21, matrix_22, matrix_23);
       const Vec3<T> row3 = deCasteljau(uu, matrix_30, matrix_31, matrix_32, matrix_33);
       
-      const Vec3<T> tangentV = deCasteljau_tangent(vv, row0, row1, row2, row3);
-      
+      tangentV = deCasteljau_tangent(vv, row0, row1, row2, row3);
+    }
+
+    template<class T>
+      static __forceinline Vec3<T> normal(const Vertex matrix[4][4], const T& uu, const T& vv) 
+    {
       /* normal = tangentU x tangentV */
-      const Vec3<T> n = cross(tangentV,tangentU);
-      return n;
+      Vec3<T> tangentU, tangentV;
+      tangents(matrix,uu,vv,tangentU,tangentV);
+      return cross(tangentV,tangentU);
     }
 
     template<typename vfloat>
       __forceinline Vec3<vfloat> normal(const vfloat& uu, const vfloat& vv) const {     
       return normal(matrix,uu,vv);
     }
+
+    template<typename vfloat>
+      __forceinline void tangents(const vfloat& uu, const vfloat& vv, Vec3<vfloat>& dPdu, Vec3<vfloat>& dPdv) const {     
+      tangents(matrix,uu,vv,dPdu,dPdv);
+    }
   };
 
   typedef BezierPatchT<Vec3fa,Vec3fa_t> BezierPatch3fa;
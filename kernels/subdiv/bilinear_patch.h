@@ -145,6 +145,12 @@ namespace embree
         return cross(eval_dv(uu,vv),eval_du(uu,vv));
       }
 
+      template<typename vfloat>
+      __forceinline void tangents(const vfloat& uu, const vfloat& vv, Vec3<vfloat>& dPdu, Vec3<vfloat>& dPdv) const {
+        dPdu = eval_du(uu,vv);
+        dPdv = eval_dv(uu,vv);
+      }
+
        template<class vfloat>
       __forceinline vfloat eval(const size_t i, const vfloat& uu, const vfloat& vv) const
       {
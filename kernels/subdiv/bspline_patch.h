@@ -411,6 +411,12 @@ namespace embree
         return cross(eval_dv(uu,vv),eval_du(uu,vv));
       }
 
+      template<typename T>
+      __forceinline void tangents(const T& uu, const T& vv, Vec3<T>& dPdu, Vec3<T>& dPdv) const {
+        dPdu = eval_du(uu,vv);
+        dPdv = eval_dv(uu,vv);
+      }
+
       void eval(const float u, const float v, 
                 Vertex* P, Vertex* dPdu, Vertex* dPdv, Vertex* ddPdudu, Vertex* ddPdvdv, Vertex* ddPdudv, 
                 const float dscale = 1.0f) const
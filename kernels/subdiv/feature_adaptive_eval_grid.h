@@ -45,9 +45,12 @@ namespace embree
       float* const Pz;
       float* const U;
       float* const V;
-      float* const Nx;
-      float* const Ny;
-      float* const Nz;
+      float* const Dux;
+      float* const Duy;
+      float* const Duz;
+      float* const Dvx;
+      float* const Dvy;
+      float* const Dvz;
       const unsigned dwidth;
       //const unsigned dheight;
       unsigned count;
@@ -57,10 +60,10 @@ namespace embree
       FeatureAdaptiveEvalGrid (const GeneralCatmullClarkPatch3fa& patch, unsigned subPatch,
                                const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight, 
                                float* Px, float* Py, float* Pz, float* U, float* V, 
-                               float* Nx, float* Ny, float* Nz,
+                               float* Dux, float* Duy, float* Duz, float* Dvx, float* Dvy, float* Dvz,
                                const unsigned dwidth, const unsigned dheight)
       : x0(x0), x1(x1), y0(y0), y1(y1), swidth(swidth), sheight(sheight), rcp_swidth(1.0f/(swidth-1.0f)), rcp_sheight(1.0f/(sheight-1.0f)), 
-        Px(Px), Py(Py), Pz(Pz), U(U), V(V), Nx(Nx), Ny(Ny), Nz(Nz), dwidth(dwidth), /*dheight(dheight),*/ count(0)
+        Px(Px), Py(Py), Pz(Pz), U(U), V(V), Dux(Dux), Duy(Duy), Duz(Duz), Dvx(Dvx), Dvy(Dvy), Dvz(Dvz), dwidth(dwidth), /*dheight(dheight),*/ count(0)
       {
         assert(swidth < (2<<20) && sheight < (2<<20));
         const BBox2f srange(Vec2f(0.0f,0.0f),Vec2f(float(swidth-1),float(sheight-1)));
@@ -128,10 +131,10 @@ namespace embree
                                const BBox2f& srange, const BBox2f& erange, const unsigned depth,
                                const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight, 
                                float* Px, float* Py, float* Pz, float* U, float* V, 
-                               float* Nx, float* Ny, float* Nz,
+                               float* Dux, float* Duy, float* Duz, float* Dvx, float* Dvy, float* Dvz,
                                const unsigned dwidth, const unsigned dheight)
       : x0(x0), x1(x1), y0(y0), y1(y1), swidth(swidth), sheight(sheight), rcp_swidth(1.0f/(swidth-1.0f)), rcp_sheight(1.0f/(sheight-1.0f)), 
-        Px(Px), Py(Py), Pz(Pz), U(U), V(V), Nx(Nx), Ny(Ny), Nz(Nz), dwidth(dwidth), /*dheight(dheight),*/ count(0)
+        Px(Px), Py(Py), Pz(Pz), U(U), V(V), Dux(Dux), Duy(Duy), Duz(Duz), Dvx(Dvx), Dvy(Dvy), Dvz(Dvz), dwidth(dwidth), /*dheight(dheight),*/ count(0)
       {
         eval(patch,srange,erange,depth);
       }
@@ -141,6 +144,8 @@ namespace embree
       {
         const float scale_x = rcp(srange.upper.x-srange.lower.x);
         const float scale_y = rcp(srange.upper.y-srange.lower.y);
+        const float dscale_x = scale_x*(swidth-1.0f);  // derivatives with respect to u,v instead of local patch coordinates
+        const float dscale_y = scale_y*(sheight-1.0f);
         count += (lx1-lx0)*(ly1-ly0);
         
 #if 0
@@ -164,8 +169,11 @@ namespace embree
             const vfloatx lu = select(ix == swidth -1, vfloatx(1.0f), (vfloatx(ix)-srange.lower.x)*scale_x);
             const vfloatx lv = select(iy == sheight-1, vfloatx(1.0f), (vfloatx(iy)-srange.lower.y)*scale_y);
             const Vec3<vfloatx> p = patch.eval(lu,lv);
-            Vec3<vfloatx> n = zero;
-            if (unlikely(Nx != nullptr)) n = normalize_safe(patch.normal(lu,lv));
+            Vec3<vfloatx> du = zero, dv = zero;
+            if (unlikely(Dux != nullptr)) {
+              patch.tangents(lu,lv,du,dv);
+              du = du*vfloatx(dscale_x); dv = dv*vfloatx(dscale_y);
+            }
             const vfloatx u = vfloatx(ix)*rcp_swidth;
             const vfloatx v = vfloatx(iy)*rcp_sheight;
             const vintx ofs = (iy-y0)*dwidth+(ix-x0);
@@ -176,10 +184,13 @@ namespace embree
               vfloatx::storeu(Pz+ofs2,p.z);
               vfloatx::storeu(U+ofs2,u);
               vfloatx::storeu(V+ofs2,v);
-              if (unlikely(Nx != nullptr)) {
-                vfloatx::storeu(Nx+ofs2,n.x);
-                vfloatx::storeu(Ny+ofs2,n.y);
-                vfloatx::storeu(Nz+ofs2,n.z);
+              if (unlikely(Dux != nullptr)) {
+                vfloatx::storeu(Dux+ofs2,du.x);
+                vfloatx::storeu(Duy+ofs2,du.y);
+                vfloatx::storeu(Duz+ofs2,du.z);
+                vfloatx::storeu(Dvx+ofs2,dv.x);
+                vfloatx::storeu(Dvy+ofs2,dv.y);
+                vfloatx::storeu(Dvz+ofs2,dv.z);
               }
             } else {
               foreach_unique_index(valid,iy,[&](const vboolx& valid, const int iy0, const int j) {
@@ -189,10 +200,13 @@ namespace embree
                   vfloatx::storeu(valid,Pz+ofs2,p.z);
                   vfloatx::storeu(valid,U+ofs2,u);
                   vfloatx::storeu(valid,V+ofs2,v);
-                  if (unlikely(Nx != nullptr)) {
-                    vfloatx::storeu(valid,Nx+ofs2,n.x);
-                    vfloatx::storeu(valid,Ny+ofs2,n.y);
-                    vfloatx::storeu(valid,Nz+ofs2,n.z);
+                  if (unlikely(Dux != nullptr)) {
+                    vfloatx::storeu(valid,Dux+ofs2,du.x);
+                    vfloatx::storeu(valid,Duy+ofs2,du.y);
+                    vfloatx::storeu(valid,Duz+ofs2,du.z);
+                    vfloatx::storeu(valid,Dvx+ofs2,dv.x);
+                    vfloatx::storeu(valid,Dvy+ofs2,dv.y);
+                    vfloatx::storeu(valid,Dvz+ofs2,dv.z);
                   }
                 });
             }
@@ -271,7 +285,8 @@ namespace embree
     template<typename Eval, typename Patch>
       bool stitch_col(const Patch& patch, int subPatch,
                       const bool right, const unsigned y0, const unsigned y1, const int fine_y, const int coarse_y, 
-                      float* Px, float* Py, float* Pz, float* U, float* V, float* Nx, float* Ny, float* Nz, const unsigned dx0, const unsigned dwidth, const unsigned dheight)
+                      float* Px, float* Py, float* Pz, float* U, float* V, 
+                      float* Dux, float* Duy, float* Duz, float* Dvx, float* Dvy, float* Dvz, const unsigned dx0, const unsigned dwidth, const unsigned dheight)
     {
       assert(coarse_y <= fine_y);
       if (likely(fine_y == coarse_y))
@@ -286,10 +301,15 @@ namespace embree
       dynamic_large_stack_array(float,pz,M,64*sizeof(float));
       dynamic_large_stack_array(float,u,M,64*sizeof(float));
       dynamic_large_stack_array(float,v,M,64*sizeof(float));
-      dynamic_large_stack_array(float,nx,M,64*sizeof(float));
-      dynamic_large_stack_array(float,ny,M,64*sizeof(float));
-      dynamic_large_stack_array(float,nz,M,64*sizeof(float));
-      Eval(patch,subPatch, right,right, y0s,y1s, 2,coarse_y+1, px,py,pz,u,v, Nx ? (float*)nx : nullptr,Ny ? (float*)ny : nullptr ,Nz ? (float*)nz : nullptr, 1,4097);
+      dynamic_large_stack_array(float,dux,M,64*sizeof(float));
+      dynamic_large_stack_array(float,duy,M,64*sizeof(float));
+      dynamic_large_stack_array(float,duz,M,64*sizeof(float));
+      dynamic_large_stack_array(float,dvx,M,64*sizeof(float));
+      dynamic_large_stack_array(float,dvy,M,64*sizeof(float));
+      dynamic_large_stack_array(float,dvz,M,64*sizeof(float));
+      const bool D = Dux != nullptr;
+      Eval(patch,subPatch, right,right, y0s,y1s, 2,coarse_y+1, px,py,pz,u,v, 
+           D ? (float*)dux : nullptr, D ? (float*)duy : nullptr, D ? (float*)duz : nullptr, D ? (float*)dvx : nullptr, D ? (float*)dvy : nullptr, D ? (float*)dvz : nullptr, 1,4097);
       
       for (unsigned y=y0; y<=y1; y++) 
       {
@@ -299,10 +319,13 @@ namespace embree
         Pz[(y-y0)*dwidth+dx0] = pz[ys];
         U [(y-y0)*dwidth+dx0] = u[ys];
         V [(y-y0)*dwidth+dx0] = v[ys];
-        if (unlikely(Nx != nullptr)) {
-          Nx[(y-y0)*dwidth+dx0] = nx[ys];
-          Ny[(y-y0)*dwidth+dx0] = ny[ys];
-          Nz[(y-y0)*dwidth+dx0] = nz[ys];
+        if (unlikely(D)) {
+          Dux[(y-y0)*dwidth+dx0] = dux[ys];
+          Duy[(y-y0)*dwidth+dx0] = duy[ys];
+          Duz[(y-y0)*dwidth+dx0] = duz[ys];
+          Dvx[(y-y0)*dwidth+dx0] = dvx[ys];
+          Dvy[(y-y0)*dwidth+dx0] = dvy[ys];
+          Dvz[(y-y0)*dwidth+dx0] = dvz[ys];
         }
       }
       return true;
@@ -311,7 +334,8 @@ namespace embree
     template<typename Eval, typename Patch>
       bool stitch_row(const Patch& patch, int subPatch, 
                       const bool bottom, const unsigned x0, const unsigned x1, const int fine_x, const int coarse_x, 
-                      float* Px, float* Py, float* Pz, float* U, float* V, float* Nx, float* Ny, float* Nz, const unsigned dy0, const unsigned dwidth, const unsigned dheight)
+                      float* Px, float* Py, float* Pz, float* U, float* V, 
+                      float* Dux, float* Duy, float* Duz, float* Dvx, float* Dvy, float* Dvz, const unsigned dy0, const unsigned dwidth, const unsigned dheight)
     {
       assert(coarse_x <= fine_x);
       if (likely(fine_x == coarse_x))
@@ -326,10 +350,15 @@ namespace embree
       dynamic_large_stack_array(float,pz,M,64*sizeof(float));
       dynamic_large_stack_array(float,u,M,64*sizeof(float));
       dynamic_large_stack_array(float,v,M,64*sizeof(float));
-      dynamic_large_stack_array(float,nx,M,64*sizeof(float));
-      dynamic_large_stack_array(float,ny,M,64*sizeof(float));
-      dynamic_large_stack_array(float,nz,M,64*sizeof(float));
-      Eval(patch,subPatch, x0s,x1s, bottom,bottom, coarse_x+1,2, px,py,pz,u,v, Nx ? (float*)nx :nullptr,Ny ? (float*)ny : nullptr , Nz ? (float*)nz : nullptr, 4097,1);
+      dynamic_large_stack_array(float,dux,M,64*sizeof(float));
+      dynamic_large_stack_array(float,duy,M,64*sizeof(float));
+      dynamic_large_stack_array(float,duz,M,64*sizeof(float));
+      dynamic_large_stack_array(float,dvx,M,64*sizeof(float));
+      dynamic_large_stack_array(float,dvy,M,64*sizeof(float));
+      dynamic_large_stack_array(float,dvz,M,64*sizeof(float));
+      const bool D = Dux != nullptr;
+      Eval(patch,subPatch, x0s,x1s, bottom,bottom, coarse_x+1,2, px,py,pz,u,v, 
+           D ? (float*)dux : nullptr, D ? (float*)duy : nullptr, D ? (float*)duz : nullptr, D ? (float*)dvx : nullptr, D ? (float*)dvy : nullptr, D ? (float*)dvz : nullptr, 4097,1);
       
       for (unsigned x=x0; x<=x1; x++) 
       {
@@ -339,10 +368,13 @@ namespace embree
         Pz[dy0*dwidth+x-x0] = pz[xs];
         U [dy0*dwidth+x-x0] = u[xs];
         V [dy0*dwidth+x-x0] = v[xs];
-        if (unlikely(Nx != nullptr)) {
-          Nx[dy0*dwidth+x-x0] = nx[xs];
-          Ny[dy0*dwidth+x-x0] = ny[xs];
-          Nz[dy0*dwidth+x-x0] = nz[xs];
+        if (unlikely(D)) {
+          Dux[dy0*dwidth+x-x0] = dux[xs];
+          Duy[dy0*dwidth+x-x0] = duy[xs];
+          Duz[dy0*dwidth+x-x0] = duz[xs];
+          Dvx[dy0*dwidth+x-x0] = dvx[xs];
+          Dvy[dy0*dwidth+x-x0] = dvy[xs];
+          Dvz[dy0*dwidth+x-x0] = dvz[xs];
         }
       }
       return true;
@@ -351,17 +383,20 @@ namespace embree
     template<typename Eval, typename Patch>
     void feature_adaptive_eval_grid (const Patch& patch, unsigned subPatch, const float levels[4],
                                      const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight, 
-                                     float* Px, float* Py, float* Pz, float* U, float* V, float* Nx, float* Ny, float* Nz, const unsigned dwidth, const unsigned dheight)
+                                     float* Px, float* Py, float* Pz, float* U, float* V, 
+                                     float* Dux, float* Duy, float* Duz, float* Dvx, float* Dvy, float* Dvz, const unsigned dwidth, const unsigned dheight)
     {
       bool sl = false, sr = false, st = false, sb = false;
       if (levels) {
-        sl = x0 == 0         && stitch_col<Eval,Patch>(patch,subPatch,0,y0,y1,sheight-1,int(levels[3]), Px,Py,Pz,U,V,Nx,Ny,Nz, 0    ,dwidth,dheight);
-        sr = x1 == swidth-1  && stitch_col<Eval,Patch>(patch,subPatch,1,y0,y1,sheight-1,int(levels[1]), Px,Py,Pz,U,V,Nx,Ny,Nz, x1-x0,dwidth,dheight);
-        st = y0 == 0         && stitch_row<Eval,Patch>(patch,subPatch,0,x0,x1,swidth-1,int(levels[0]), Px,Py,Pz,U,V,Nx,Ny,Nz, 0    ,dwidth,dheight);
-        sb = y1 == sheight-1 && stitch_row<Eval,Patch>(patch,subPatch,1,x0,x1,swidth-1,int(levels[2]), Px,Py,Pz,U,V,Nx,Ny,Nz, y1-y0,dwidth,dheight);
+        sl = x0 == 0         && stitch_col<Eval,Patch>(patch,subPatch,0,y0,y1,sheight-1,int(levels[3]), Px,Py,Pz,U,V,Dux,Duy,Duz,Dvx,Dvy,Dvz, 0    ,dwidth,dheight);
+        sr = x1 == swidth-1  && stitch_col<Eval,Patch>(patch,subPatch,1,y0,y1,sheight-1,int(levels[1]), Px,Py,Pz,U,V,Dux,Duy,Duz,Dvx,Dvy,Dvz, x1-x0,dwidth,dheight);
+        st = y0 == 0         && stitch_row<Eval,Patch>(patch,subPatch,0,x0,x1,swidth-1,int(levels[0]), Px,Py,Pz,U,V,Dux,Duy,Duz,Dvx,Dvy,Dvz, 0    ,dwidth,dheight);
+        sb = y1 == sheight-1 && stitch_row<Eval,Patch>(patch,subPatch,1,x0,x1,swidth-1,int(levels[2]), Px,Py,Pz,U,V,Dux,Duy,Duz,Dvx,Dvy,Dvz, y1-y0,dwidth,dheight);
       }
       const unsigned ofs = st*dwidth+sl;
-      Eval(patch,subPatch,x0+sl,x1-sr,y0+st,y1-sb, swidth,sheight, Px+ofs,Py+ofs,Pz+ofs,U+ofs,V+ofs,Nx?Nx+ofs:nullptr,Ny?Ny+ofs:nullptr,Nz?Nz+ofs:nullptr, dwidth,dheight);
+      const bool D = Dux != nullptr;
+      Eval(patch,subPatch,x0+sl,x1-sr,y0+st,y1-sb, swidth,sheight, Px+ofs,Py+ofs,Pz+ofs,U+ofs,V+ofs,
+           D?Dux+ofs:nullptr,D?Duy+ofs:nullptr,D?Duz+ofs:nullptr,D?Dvx+ofs:nullptr,D?Dvy+ofs:nullptr,D?Dvz+ofs:nullptr, dwidth,dheight);
     }
   }
 }
@@ -806,7 +806,7 @@ namespace embree
     }
 
     template<class T>
-      static __forceinline Vec3<T> normal_t(const Vertex matrix[4][4], const Vec3<T> f[2][2], const T& uu, const T& vv) 
+      static __forceinline void tangents_t(const Vertex matrix[4][4], const Vec3<T> f[2][2], const T& uu, const T& vv, Vec3<T>& tangentU, Vec3<T>& tangentV) 
     {
       typedef typename T::Bool M;
       
@@ -867,7 +867,7 @@ namespace embree
       const Vec3<T> col2 = deCasteljau(vv, matrix_02, matrix_12, matrix_22, matrix_32);
       const Vec3<T> col3 = deCasteljau(vv, matrix_03, matrix_13, matrix_23, matrix_33);
       
-      const Vec3<T> tangentU = deCasteljau_tangent(uu, col0, col1, col2, col3);
+      tangentU = deCasteljau_tangent(uu, col0, col1, col2, col3);
       
       /* tangentV */
       const Vec3<T> row0 = deCasteljau(uu, matrix_00, matrix_01, matrix_02, matrix_03);
@@ -875,11 +875,16 @@ namespace embree
       const Vec3<T> row2 = deCasteljau(uu, matrix_20, matrix_21, matrix_22, matrix_23);
       const Vec3<T> row3 = deCasteljau(uu, matrix_30, matrix_31, matrix_32, matrix_33);
       
-      const Vec3<T> tangentV = deCasteljau_tangent(vv, row0, row1, row2, row3);
-      
+      tangentV = deCasteljau_tangent(vv, row0, row1, row2, row3);
+    }
+
+    template<class T>
+      static __forceinline Vec3<T> normal_t(const Vertex matrix[4][4], const Vec3<T> f[2][2], const T& uu, const T& vv) 
+    {
       /* normal = tangentU x tangentV */
-      const Vec3<T> n = cross(tangentV,tangentU);
-      return n;
+      Vec3<T> tangentU, tangentV;
+      tangents_t(matrix,f,uu,vv,tangentU,tangentV);
+      return cross(tangentV,tangentU);
     }
 
      template<class T>
@@ -893,6 +898,17 @@ namespace embree
       return normal_t(v,ff,uu,vv);
     }
 
+    template<class T>
+    __forceinline void tangents(const T& uu, const T& vv, Vec3<T>& dPdu, Vec3<T>& dPdv) const 
+    {
+      Vec3<T> ff[2][2];
+      ff[0][0] = Vec3<T>(f[0][0]);
+      ff[0][1] = Vec3<T>(f[0][1]);
+      ff[1][1] = Vec3<T>(f[1][1]);
+      ff[1][0] = Vec3<T>(f[1][0]);
+      tangents_t(v,ff,uu,vv,dPdu,dPdv);
+    }
+
     __forceinline BBox<Vertex> bounds() const
     {
       const Vertex *const cv = &v[0][0];
@@ -93,6 +93,17 @@ namespace embree
       return GregoryPatch3fa::normal_t(matrix,f_m,uu,vv);
     }
 
+    template<class T>
+      __forceinline void tangents(const T &uu, const T &vv, Vec3<T>& dPdu, Vec3<T>& dPdv) const 
+    {
+      Vec3<T> f_m[2][2];
+      f_m[0][0] = Vec3<T>( matrix[0][0].w, matrix[0][1].w, matrix[0][2].w );
+      f_m[0][1] = Vec3<T>( matrix[1][0].w, matrix[1][1].w, matrix[1][2].w );
+      f_m[1][1] = Vec3<T>( matrix[2][0].w, matrix[2][1].w, matrix[2][2].w );
+      f_m[1][0] = Vec3<T>( matrix[3][0].w, matrix[3][1].w, matrix[3][2].w );
+      GregoryPatch3fa::tangents_t(matrix,f_m,uu,vv,dPdu,dPdv);
+    }
+
     __forceinline void eval(const float u, const float v, 
                             Vec3fa* P, Vec3fa* dPdu, Vec3fa* dPdv, Vec3fa* ddPdudu, Vec3fa* ddPdvdv, Vec3fa* ddPdudv,
                             const float dscale = 1.0f) const
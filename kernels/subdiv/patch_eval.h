@@ -43,7 +43,7 @@ namespace embree
           Ref patch = SharedLazyTessellationCache::lookup(entry,commitCounter,[&] () {
               auto alloc = [&](size_t bytes) { return SharedLazyTessellationCache::malloc(bytes); };
               return Patch::create(alloc,edge,vertices,stride);
-            },true);
+            });
 
           auto curTime = SharedLazyTessellationCache::sharedLazyTessellationCache.getTime(commitCounter);
           const bool allAllocationsValid = SharedLazyTessellationCache::validTime(time,curTime);
@@ -56,6 +56,16 @@ namespace embree
           FeatureAdaptiveEval<Vertex,Vertex_t>(edge,vertices,stride,u,v,P,dPdu,dPdv,ddPdudu,ddPdvdv,ddPdudv);
           PATCH_DEBUG_SUBDIVISION(edge,c,-1,-1);
         }
+
+        /* evaluates a precalculated patch hierarchy */
+        PatchEval (Ref patch, const HalfEdge* edge, const char* vertices, size_t stride, const float u, const float v, 
+                   Vertex* P, Vertex* dPdu, Vertex* dPdv, Vertex* ddPdudu, Vertex* ddPdvdv, Vertex* ddPdudv)
+        : P(P), dPdu(dPdu), dPdv(dPdv), ddPdudu(ddPdudu), ddPdvdv(ddPdvdv), ddPdudv(ddPdudv)
+        {
+          if (patch && eval(patch,u,v,1.0f,0)) 
+            return;
+          FeatureAdaptiveEval<Vertex,Vertex_t>(edge,vertices,stride,u,v,P,dPdu,dPdv,ddPdudu,ddPdvdv,ddPdudv);
+        }
         
         __forceinline bool eval_quad(const typename Patch::SubdividedQuadPatch* This, const float u, const float v, const float dscale, const size_t depth)
         {
@@ -44,9 +44,12 @@ namespace embree
       float* const Pz;
       float* const U;
       float* const V;
-      float* const Nx;
-      float* const Ny;
-      float* const Nz;
+      float* const Dux;
+      float* const Duy;
+      float* const Duz;
+      float* const Dvx;
+      float* const Dvy;
+      float* const Dvz;
       const unsigned dwidth,dheight;
       unsigned count;
 
@@ -55,10 +58,10 @@ namespace embree
       PatchEvalGrid (Ref patch, unsigned subPatch,
                      const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight, 
                      float* Px, float* Py, float* Pz, float* U, float* V, 
-                     float* Nx, float* Ny, float* Nz,
+                     float* Dux, float* Duy, float* Duz, float* Dvx, float* Dvy, float* Dvz,
                      const unsigned dwidth, const unsigned dheight)
       : x0(x0), x1(x1), y0(y0), y1(y1), swidth(swidth), sheight(sheight), rcp_swidth(1.0f/(swidth-1.0f)), rcp_sheight(1.0f/(sheight-1.0f)), 
-        Px(Px), Py(Py), Pz(Pz), U(U), V(V), Nx(Nx), Ny(Ny), Nz(Nz), dwidth(dwidth), dheight(dheight), count(0)
+        Px(Px), Py(Py), Pz(Pz), U(U), V(V), Dux(Dux), Duy(Duy), Duz(Duz), Dvx(Dvx), Dvy(Dvy), Dvz(Dvz), dwidth(dwidth), dheight(dheight), count(0)
       {
         assert(swidth < (2<<20) && sheight < (2<<20));
         const BBox2f srange(Vec2f(0.0f,0.0f),Vec2f(float(swidth-1),float(sheight-1)));
@@ -73,6 +76,8 @@ namespace embree
       {
         const float scale_x = rcp(srange.upper.x-srange.lower.x);
         const float scale_y = rcp(srange.upper.y-srange.lower.y);
+        const float dscale_x = scale_x*(swidth-1.0f);  // derivatives with respect to u,v instead of local patch coordinates
+        const float dscale_y = scale_y*(sheight-1.0f);
         count += (lx1-lx0)*(ly1-ly0);
         
 #if 0
@@ -96,8 +101,11 @@ namespace embree
             const vfloatx lu = select(ix == swidth -1, vfloatx(1.0f), (vfloatx(ix)-srange.lower.x)*scale_x);
             const vfloatx lv = select(iy == sheight-1, vfloatx(1.0f), (vfloatx(iy)-srange.lower.y)*scale_y);
             const Vec3<vfloatx> p = patch->patch.eval(lu,lv);
-            Vec3<vfloatx> n = zero;
-            if (unlikely(Nx != nullptr)) n = normalize_safe(patch->patch.normal(lu,lv));
+            Vec3<vfloatx> du = zero, dv = zero;
+            if (unlikely(Dux != nullptr)) {
+              patch->patch.tangents(lu,lv,du,dv);
+              du = du*vfloatx(dscale_x); dv = dv*vfloatx(dscale_y);
+            }
             const vfloatx u = vfloatx(ix)*rcp_swidth;
             const vfloatx v = vfloatx(iy)*rcp_sheight;
             const vintx ofs = (iy-y0)*dwidth+(ix-x0);
@@ -108,10 +116,13 @@ namespace embree
               vfloatx::storeu(Pz+ofs2,p.z);
               vfloatx::storeu(U+ofs2,u);
               vfloatx::storeu(V+ofs2,v);
-              if (unlikely(Nx != nullptr)) {
-                vfloatx::storeu(Nx+ofs2,n.x);
-                vfloatx::storeu(Ny+ofs2,n.y);
-                vfloatx::storeu(Nz+ofs2,n.z);
+              if (unlikely(Dux != nullptr)) {
+                vfloatx::storeu(Dux+ofs2,du.x);
+                vfloatx::storeu(Duy+ofs2,du.y);
+                vfloatx::storeu(Duz+ofs2,du.z);
+                vfloatx::storeu(Dvx+ofs2,dv.x);
+                vfloatx::storeu(Dvy+ofs2,dv.y);
+                vfloatx::storeu(Dvz+ofs2,dv.z);
               }
             } else {
               foreach_unique_index(valid,iy,[&](const vboolx& valid, const int iy0, const int j) {
@@ -121,10 +132,13 @@ namespace embree
                   vfloatx::storeu(valid,Pz+ofs2,p.z);
                   vfloatx::storeu(valid,U+ofs2,u);
                   vfloatx::storeu(valid,V+ofs2,v);
-                  if (unlikely(Nx != nullptr)) {
-                    vfloatx::storeu(valid,Nx+ofs2,n.x);
-                    vfloatx::storeu(valid,Ny+ofs2,n.y);
-                    vfloatx::storeu(valid,Nz+ofs2,n.z);
+                  if (unlikely(Dux != nullptr)) {
+                    vfloatx::storeu(valid,Dux+ofs2,du.x);
+                    vfloatx::storeu(valid,Duy+ofs2,du.y);
+                    vfloatx::storeu(valid,Duz+ofs2,du.z);
+                    vfloatx::storeu(valid,Dvx+ofs2,dv.x);
+                    vfloatx::storeu(valid,Dvy+ofs2,dv.y);
+                    vfloatx::storeu(valid,Dvz+ofs2,dv.z);
                   }
                 });
             }
@@ -182,7 +196,7 @@ namespace embree
         }
         case Patch::EVAL_PATCH: { 
           CatmullClarkPatch patch; patch.deserialize(This.object());
-          FeatureAdaptiveEvalGrid(patch,srange,erange,depth,x0,x1,y0,y1,swidth,sheight,Px,Py,Pz,U,V,Nx,Ny,Nz,dwidth,dheight);
+          FeatureAdaptiveEvalGrid(patch,srange,erange,depth,x0,x1,y0,y1,swidth,sheight,Px,Py,Pz,U,V,Dux,Duy,Duz,Dvx,Dvy,Dvz,dwidth,dheight);
           count += (lx1-lx0)*(ly1-ly0);
           return true;
         }
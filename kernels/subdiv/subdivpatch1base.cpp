@@ -84,9 +84,9 @@ namespace embree
     int width  = (int)max(level[0],level[2])+1; // n segments -> n+1 points
     int height = (int)max(level[1],level[3])+1;
     
-    /* workaround for 2x2 intersection stencil */
-    width = max(width,2); // FIXME: this triggers stitching
-    height = max(height,2);
+    /* workaround for 3x3 intersection stencil, a 2x2 grid would read past its end */
+    width = max(width,3); // FIXME: this triggers stitching
+    height = max(height,3);
 
     return Vec2i(width,height);
   }
@@ -43,6 +43,7 @@ namespace embree
 
     enum Flags {
       TRANSITION_PATCH       = 16, 
+      LAST_PATCH             = 32,  //!< last patch of the patch array
     };
 
     /*! Default constructor. */
@@ -152,11 +153,86 @@ namespace embree
                   float *__restrict__ const grid_v,
                   const SubdivMesh* const geom);
 
-    /* eval grid over patch and stich edges when required */      
+    /* eval grid over patch and stich edges when required */
     BBox3fa evalGridBounds(const SubdivPatch1Base& patch,
                            const unsigned x0, const unsigned x1,
                            const unsigned y0, const unsigned y1,
                            const unsigned swidth, const unsigned sheight,
                            const SubdivMesh* const geom);
+
+    /*! Evaluates the grids of multiple patches of one mesh into a
+     *  single SOA buffer and invokes the batched displacement function
+     *  once for all of them. */
+    class GridBatch
+    {
+    public:
+
+      /*! batches get evaluated once they reach this number of points */
+      static const size_t MAX_POINTS = 16*1024;
+
+      /*! number of arrays of the SOA buffer */
+      enum { U, V, NX, NY, NZ, DUX, DUY, DUZ, DVX, DVY, DVZ, PX, PY, PZ, NUM_ARRAYS };
+
+    public:
+      GridBatch (const SubdivMesh* geom)
+        : geom(geom), numPoints(0), data(nullptr), dataPoints(0) {}
+
+      ~GridBatch () {
+        alignedFree(data);
+      }
+
+      /*! checks if the grids of some mesh should get evaluated in batches */
+      static bool enabled(const SubdivMesh* geom);
+
+      /*! adds a grid of some patch to the batch, the patch has to stay alive until the batch is evaluated */
+      size_t add(const SubdivPatch1Base& patch, const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight);
+
+      /*! adds the complete grid of some patch to the batch */
+      __forceinline size_t add(const SubdivPatch1Base& patch) {
+        return add(patch,0,patch.grid_u_res-1,0,patch.grid_v_res-1,patch.grid_u_res,patch.grid_v_res);
+      }
+
+      /*! evaluates and displaces all grids */
+      void eval();
+
+      /*! copies a range of an evaluated grid into padded arrays */
+      void get(size_t i, const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1,
+               float* grid_x, float* grid_y, float* grid_z, float* grid_u, float* grid_v) const;
+
+      /*! returns the bounds of an evaluated grid */
+      BBox3fa bounds(size_t i) const;
+
+      /*! returns true if the batch should get evaluated */
+      __forceinline bool full() const { return numPoints >= MAX_POINTS; }
+
+      /*! returns the number of grids in the batch */
+      __forceinline size_t size() const { return grids.size(); }
+
+      /*! removes all grids from the batch */
+      __forceinline void clear() { grids.clear(); numPoints = 0; }
+
+    private:
+      __forceinline const float* array(size_t i) const { return data + i*numPoints; }
+      __forceinline       float* array(size_t i)       { return data + i*numPoints; }
+
+      /* make non-copyable */
+      GridBatch (const GridBatch& other) DELETED; // do not implement
+      GridBatch& operator= (const GridBatch& other) DELETED; // do not implement
+
+    private:
+      struct Grid
+      {
+        const SubdivPatch1Base* patch;
+        unsigned x0,x1,y0,y1;
+        unsigned swidth,sheight;
+        unsigned begin;           //!< index of first point of the grid in all arrays
+      };
+
+      const SubdivMesh* geom;
+      std::vector<Grid> grids;
+      size_t numPoints;           //!< number of points of all grids including padding
+      float* data;                //!< NUM_ARRAYS arrays of numPoints floats, 64 bytes aligned
+      size_t dataPoints;          //!< number of points data got allocated for
+    };
   }
 }
@@ -15,6 +15,8 @@
 // ======================================================================== //
 
 #include "subdivpatch1base.h"
+#include "tessellation_cache_file.h"
+#include "../common/scene.h"
 
 namespace embree
 {
@@ -66,38 +68,68 @@ namespace embree
       return Vec3<simdf>( zero );
     }
 
-    /* eval grid over patch and stich edges when required */      
-    void evalGrid(const SubdivPatch1Base& patch,
-                  const unsigned x0, const unsigned x1,
-                  const unsigned y0, const unsigned y1,
-                  const unsigned swidth, const unsigned sheight,
-                  float *__restrict__ const grid_x,
-                  float *__restrict__ const grid_y,
-                  float *__restrict__ const grid_z,
-                  float *__restrict__ const grid_u,
-                  float *__restrict__ const grid_v,
-                  const SubdivMesh* const geom)
+    template<typename simdf>
+      void patchTangents(const SubdivPatch1Base& patch, const simdf& uu, const simdf& vv, Vec3<simdf>& dPdu, Vec3<simdf>& dPdv) 
+    {
+      if (likely(patch.type == SubdivPatch1Base::BEZIER_PATCH))
+        ((BezierPatch3fa*)patch.patch_v)->tangents(uu,vv,dPdu,dPdv);
+      else if (likely(patch.type == SubdivPatch1Base::BSPLINE_PATCH))
+        ((BSplinePatch3fa*)patch.patch_v)->tangents(uu,vv,dPdu,dPdv);
+      else if (likely(patch.type == SubdivPatch1Base::GREGORY_PATCH))
+        ((DenseGregoryPatch3fa*)patch.patch_v)->tangents(uu,vv,dPdu,dPdv);
+      else {
+        dPdu = Vec3<simdf>( zero );
+        dPdv = Vec3<simdf>( zero );
+      }
+    }
+
+    /* fills the elements of the arrays after the last grid point with the last grid point */
+    static __forceinline void padGrid(float* const* arrays, const size_t numArrays, const unsigned first, const unsigned end)
+    {
+      for (size_t j=0; j<numArrays; j++) {
+        const float last = arrays[j][first-1];
+        for (unsigned i=first; i<end; i++)
+          arrays[j][i] = last;
+      }
+    }
+
+    /* eval grid over patch and stich edges when required, optionally
+     * also evaluates the tangents with respect to the patch u/v
+     * coordinates when grid_dux is not null */
+    static void evalGridBase(const SubdivPatch1Base& patch,
+                             const unsigned x0, const unsigned x1,
+                             const unsigned y0, const unsigned y1,
+                             const unsigned swidth, const unsigned sheight,
+                             float *__restrict__ const grid_x,
+                             float *__restrict__ const grid_y,
+                             float *__restrict__ const grid_z,
+                             float *__restrict__ const grid_u,
+                             float *__restrict__ const grid_v,
+                             float *__restrict__ const grid_dux,
+                             float *__restrict__ const grid_duy,
+                             float *__restrict__ const grid_duz,
+                             float *__restrict__ const grid_dvx,
+                             float *__restrict__ const grid_dvy,
+                             float *__restrict__ const grid_dvz,
+                             const SubdivMesh* const geom)
     {
       const unsigned dwidth  = x1-x0+1;
       const unsigned dheight = y1-y0+1;
       const unsigned M = dwidth*dheight+VSIZEX;
       const unsigned grid_size_simd_blocks = (M-1)/VSIZEX;
+      const bool D = grid_dux != nullptr;
 
       if (unlikely(patch.type == SubdivPatch1Base::EVAL_PATCH))
       {
-        const bool displ = geom->displFunc || geom->displFunc2;
-        const unsigned N = displ ? M : 0;
-        dynamic_large_stack_array(float,grid_Ng_x,N,64*64*sizeof(float));
-        dynamic_large_stack_array(float,grid_Ng_y,N,64*64*sizeof(float));
-        dynamic_large_stack_array(float,grid_Ng_z,N,64*64*sizeof(float));
-        
-        if (geom->patch_eval_trees.size())
+        /* use the precalculated patch hierarchy of the patch table if available */
+        const Patch3fa::Ref tree = geom->patch_eval_trees.size() ? geom->patch_eval_trees[geom->numTimeSteps*patch.prim+patch.time()] : Patch3fa::Ref();
+        if (tree)
         {
           feature_adaptive_eval_grid<PatchEvalGrid> 
-            (geom->patch_eval_trees[geom->numTimeSteps*patch.prim+patch.time()], patch.subPatch(), patch.needsStitching() ? patch.level : nullptr,
+            (tree, patch.subPatch(), patch.needsStitching() ? patch.level : nullptr,
              x0,x1,y0,y1,swidth,sheight,
              grid_x,grid_y,grid_z,grid_u,grid_v,
-             displ ? (float*)grid_Ng_x : nullptr, displ ? (float*)grid_Ng_y : nullptr, displ ? (float*)grid_Ng_z : nullptr,
+             grid_dux,grid_duy,grid_duz,grid_dvx,grid_dvy,grid_dvz,
              dwidth,dheight);
         }
         else 
@@ -108,7 +140,7 @@ namespace embree
             (ccpatch, patch.subPatch(), patch.needsStitching() ? patch.level : nullptr,
             x0,x1,y0,y1,swidth,sheight,
             grid_x,grid_y,grid_z,grid_u,grid_v,
-            displ ? (float*)grid_Ng_x : nullptr, displ ? (float*)grid_Ng_y : nullptr, displ ? (float*)grid_Ng_z : nullptr,
+            grid_dux,grid_duy,grid_duz,grid_dvx,grid_dvy,grid_dvz,
             dwidth,dheight);
         }
 
@@ -125,27 +157,26 @@ namespace embree
           const vfloatx patch_v = lerp2(uv0.y,uv1.y,uv3.y,uv2.y,u,v);
           vfloatx::store(&grid_u[i*VSIZEX],patch_u);
           vfloatx::store(&grid_v[i*VSIZEX],patch_v);
-        }
 
-        /* call displacement shader */
-        if (unlikely(geom->displFunc))
-          geom->displFunc(geom->userPtr,patch.geom,patch.prim,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
-        else if (unlikely(geom->displFunc2))
-          geom->displFunc2(geom->userPtr,patch.geom,patch.prim,patch.time(),grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
-
-        /* set last elements in u,v array to 1.0f */
-        const float last_u = grid_u[dwidth*dheight-1];
-        const float last_v = grid_v[dwidth*dheight-1];
-        const float last_x = grid_x[dwidth*dheight-1];
-        const float last_y = grid_y[dwidth*dheight-1];
-        const float last_z = grid_z[dwidth*dheight-1];
-        for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++)
-        {
-          grid_u[i] = last_u;
-          grid_v[i] = last_v;
-          grid_x[i] = last_x;
-          grid_y[i] = last_y;
-          grid_z[i] = last_z;
+          /* transform tangents with the inverse Jacobian of the sub-patch to patch UV mapping */
+          if (unlikely(D))
+          {
+            const vfloatx dUdu = (1.0f-v)*(uv1.x-uv0.x) + v*(uv2.x-uv3.x);
+            const vfloatx dUdv = (1.0f-u)*(uv3.x-uv0.x) + u*(uv2.x-uv1.x);
+            const vfloatx dVdu = (1.0f-v)*(uv1.y-uv0.y) + v*(uv2.y-uv3.y);
+            const vfloatx dVdv = (1.0f-u)*(uv3.y-uv0.y) + u*(uv2.y-uv1.y);
+            const vfloatx rcp_det = rcp(dUdu*dVdv-dUdv*dVdu);
+            const Vec3<vfloatx> Pu(vfloatx::load(&grid_dux[i*VSIZEX]),vfloatx::load(&grid_duy[i*VSIZEX]),vfloatx::load(&grid_duz[i*VSIZEX]));
+            const Vec3<vfloatx> Pv(vfloatx::load(&grid_dvx[i*VSIZEX]),vfloatx::load(&grid_dvy[i*VSIZEX]),vfloatx::load(&grid_dvz[i*VSIZEX]));
+            const Vec3<vfloatx> dPdu = (Pu*dVdv - Pv*dVdu)*rcp_det;
+            const Vec3<vfloatx> dPdv = (Pv*dUdu - Pu*dUdv)*rcp_det;
+            vfloatx::store(&grid_dux[i*VSIZEX],dPdu.x);
+            vfloatx::store(&grid_duy[i*VSIZEX],dPdu.y);
+            vfloatx::store(&grid_duz[i*VSIZEX],dPdu.z);
+            vfloatx::store(&grid_dvx[i*VSIZEX],dPdv.x);
+            vfloatx::store(&grid_dvy[i*VSIZEX],dPdv.y);
+            vfloatx::store(&grid_dvz[i*VSIZEX],dPdv.z);
+          }
         }
       }
       else
@@ -154,12 +185,8 @@ namespace embree
         gridUVTessellator(patch.level,swidth,sheight,x0,y0,dwidth,dheight,grid_u,grid_v);
       
         /* set last elements in u,v array to last valid point */
-        const float last_u = grid_u[dwidth*dheight-1];
-        const float last_v = grid_v[dwidth*dheight-1];
-        for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++) {
-          grid_u[i] = last_u;
-          grid_v[i] = last_v;
-        }
+        float* const grid_uv[2] = { grid_u, grid_v };
+        padGrid(grid_uv,2,dwidth*dheight,grid_size_simd_blocks*VSIZEX);
 
         /* stitch edges if necessary */
         if (unlikely(patch.needsStitching()))
@@ -170,199 +197,180 @@ namespace embree
         {
           const vfloatx u = vfloatx::load(&grid_u[i*VSIZEX]);
           const vfloatx v = vfloatx::load(&grid_v[i*VSIZEX]);
-          Vec3<vfloatx> vtx = patchEval(patch,u,v);
-        
-          /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
-          {
-            const Vec3<vfloatx> normal = normalize_safe(patchNormal(patch, u, v));
-            geom->displFunc(geom->userPtr,patch.geom,patch.prim,
-                            &u[0],&v[0],&normal.x[0],&normal.y[0],&normal.z[0],
-                            &vtx.x[0],&vtx.y[0],&vtx.z[0],VSIZEX);
-          
-          } 
-          else if (unlikely(geom->displFunc2 != nullptr))
-          {
-            const Vec3<vfloatx> normal = normalize_safe(patchNormal(patch, u, v));
-            geom->displFunc2(geom->userPtr,patch.geom,patch.prim,patch.time(),
-                             &u[0],&v[0],&normal.x[0],&normal.y[0],&normal.z[0],
-                             &vtx.x[0],&vtx.y[0],&vtx.z[0],VSIZEX);
-          }
-
+          const Vec3<vfloatx> vtx = patchEval(patch,u,v);
           vfloatx::store(&grid_x[i*VSIZEX],vtx.x);
           vfloatx::store(&grid_y[i*VSIZEX],vtx.y);
           vfloatx::store(&grid_z[i*VSIZEX],vtx.z);
+
+          if (unlikely(D))
+          {
+            Vec3<vfloatx> dPdu, dPdv;
+            patchTangents(patch,u,v,dPdu,dPdv);
+            vfloatx::store(&grid_dux[i*VSIZEX],dPdu.x);
+            vfloatx::store(&grid_duy[i*VSIZEX],dPdu.y);
+            vfloatx::store(&grid_duz[i*VSIZEX],dPdu.z);
+            vfloatx::store(&grid_dvx[i*VSIZEX],dPdv.x);
+            vfloatx::store(&grid_dvy[i*VSIZEX],dPdv.y);
+            vfloatx::store(&grid_dvz[i*VSIZEX],dPdv.z);
+          }
         }
       }
+
+      /* set last elements to last valid point */
+      float* const grids[11] = { grid_x, grid_y, grid_z, grid_u, grid_v, grid_dux, grid_duy, grid_duz, grid_dvx, grid_dvy, grid_dvz };
+      padGrid(grids,D ? 11 : 5,dwidth*dheight,grid_size_simd_blocks*VSIZEX);
     }
 
+    /* computes normalized geometry normals from the tangents, the normals get stored into the dPdu arrays */
+    static void tangentsToNormals(const size_t N, float* const dux, float* const duy, float* const duz, const float* const dvx, const float* const dvy, const float* const dvz)
+    {
+      for (size_t i=0; i<N; i+=VSIZEX)
+      {
+        const Vec3<vfloatx> dPdu(vfloatx::load(&dux[i]),vfloatx::load(&duy[i]),vfloatx::load(&duz[i]));
+        const Vec3<vfloatx> dPdv(vfloatx::load(&dvx[i]),vfloatx::load(&dvy[i]),vfloatx::load(&dvz[i]));
+        const Vec3<vfloatx> Ng = normalize_safe(cross(dPdv,dPdu));
+        vfloatx::store(&dux[i],Ng.x);
+        vfloatx::store(&duy[i],Ng.y);
+        vfloatx::store(&duz[i],Ng.z);
+      }
+    }
 
-    /* eval grid over patch and stich edges when required */      
-    BBox3fa evalGridBounds(const SubdivPatch1Base& patch,
-                           const unsigned x0, const unsigned x1,
-                           const unsigned y0, const unsigned y1,
-                           const unsigned swidth, const unsigned sheight,
-                           const SubdivMesh* const geom)
+    /* eval grid over patch, stich edges when required, and apply displacement function */
+    static void evalGridDirect(const SubdivPatch1Base& patch,
+                  const unsigned x0, const unsigned x1,
+                  const unsigned y0, const unsigned y1,
+                  const unsigned swidth, const unsigned sheight,
+                  float *__restrict__ const grid_x,
+                  float *__restrict__ const grid_y,
+                  float *__restrict__ const grid_z,
+                  float *__restrict__ const grid_u,
+                  float *__restrict__ const grid_v,
+                  const SubdivMesh* const geom)
     {
-      BBox3fa b(empty);
+      /* a batched displacement function gets invoked with a single grid here */
+      if (unlikely(geom->displBatchFunc != nullptr))
+      {
+        GridBatch batch(geom);
+        batch.add(patch,x0,x1,y0,y1,swidth,sheight);
+        batch.eval();
+        batch.get(0,x0,x1,y0,y1,grid_x,grid_y,grid_z,grid_u,grid_v);
+        return;
+      }
+
+      if (likely(geom->displFunc == nullptr && geom->displFunc2 == nullptr)) {
+        evalGridBase(patch,x0,x1,y0,y1,swidth,sheight,grid_x,grid_y,grid_z,grid_u,grid_v,
+                     nullptr,nullptr,nullptr,nullptr,nullptr,nullptr,geom);
+        return;
+      }
+
       const unsigned dwidth  = x1-x0+1;
       const unsigned dheight = y1-y0+1;
       const unsigned M = dwidth*dheight+VSIZEX;
       const unsigned grid_size_simd_blocks = (M-1)/VSIZEX;
-      dynamic_large_stack_array(float,grid_u,M,64*64*sizeof(float));
-      dynamic_large_stack_array(float,grid_v,M,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_dux,M,32*32*sizeof(float));
+      dynamic_large_stack_array(float,grid_duy,M,32*32*sizeof(float));
+      dynamic_large_stack_array(float,grid_duz,M,32*32*sizeof(float));
+      dynamic_large_stack_array(float,grid_dvx,M,32*32*sizeof(float));
+      dynamic_large_stack_array(float,grid_dvy,M,32*32*sizeof(float));
+      dynamic_large_stack_array(float,grid_dvz,M,32*32*sizeof(float));
+      evalGridBase(patch,x0,x1,y0,y1,swidth,sheight,grid_x,grid_y,grid_z,grid_u,grid_v,
+                   grid_dux,grid_duy,grid_duz,grid_dvx,grid_dvy,grid_dvz,geom);
 
-      if (unlikely(patch.type == SubdivPatch1Base::EVAL_PATCH))
-      {
-        const bool displ = geom->displFunc || geom->displFunc2;
-        dynamic_large_stack_array(float,grid_x,M,64*64*sizeof(float));
-        dynamic_large_stack_array(float,grid_y,M,64*64*sizeof(float));
-        dynamic_large_stack_array(float,grid_z,M,64*64*sizeof(float));
-        dynamic_large_stack_array(float,grid_Ng_x,displ ? M : 0,64*64*sizeof(float));
-        dynamic_large_stack_array(float,grid_Ng_y,displ ? M : 0,64*64*sizeof(float));
-        dynamic_large_stack_array(float,grid_Ng_z,displ ? M : 0,64*64*sizeof(float));
-
-        if (geom->patch_eval_trees.size())
-        {
-          feature_adaptive_eval_grid<PatchEvalGrid> 
-            (geom->patch_eval_trees[geom->numTimeSteps*patch.prim+patch.time()], patch.subPatch(), patch.needsStitching() ? patch.level : nullptr,
-             x0,x1,y0,y1,swidth,sheight,
-             grid_x,grid_y,grid_z,grid_u,grid_v,
-             displ ? (float*)grid_Ng_x : nullptr, displ ? (float*)grid_Ng_y : nullptr, displ ? (float*)grid_Ng_z : nullptr,
-             dwidth,dheight);
-        } 
-        else 
-        {
-          GeneralCatmullClarkPatch3fa ccpatch(patch.edge(),geom->getVertexBuffer(patch.time()));
-          
-          feature_adaptive_eval_grid <FeatureAdaptiveEvalGrid,GeneralCatmullClarkPatch3fa>
-            (ccpatch, patch.subPatch(), patch.needsStitching() ? patch.level : nullptr,
-            x0,x1,y0,y1,swidth,sheight,
-            grid_x,grid_y,grid_z,grid_u,grid_v,
-            displ ? (float*)grid_Ng_x : nullptr, displ ? (float*)grid_Ng_y : nullptr, displ ? (float*)grid_Ng_z : nullptr,
-            dwidth,dheight);
-        }
-
-        /* call displacement shader */
-        if (unlikely(geom->displFunc))
-          geom->displFunc(geom->userPtr,patch.geom,patch.prim,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
-        else if (unlikely(geom->displFunc2))
-          geom->displFunc2(geom->userPtr,patch.geom,patch.prim,patch.time(),grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
-
-        /* set last elements in u,v array to 1.0f */
-        const float last_u = grid_u[dwidth*dheight-1];
-        const float last_v = grid_v[dwidth*dheight-1];
-        const float last_x = grid_x[dwidth*dheight-1];
-        const float last_y = grid_y[dwidth*dheight-1];
-        const float last_z = grid_z[dwidth*dheight-1];
-        for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++)
-        {
-          grid_u[i] = last_u;
-          grid_v[i] = last_v;
-          grid_x[i] = last_x;
-          grid_y[i] = last_y;
-          grid_z[i] = last_z;
-        }
+      /* call displacement shader once for the whole grid */
+      float* const grid_Ng_x = grid_dux, *const grid_Ng_y = grid_duy, *const grid_Ng_z = grid_duz;
+      tangentsToNormals(grid_size_simd_blocks*VSIZEX,grid_dux,grid_duy,grid_duz,grid_dvx,grid_dvy,grid_dvz);
+      if (geom->displFunc)
+        geom->displFunc(geom->userPtr,patch.geom,patch.prim,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
+      else
+        geom->displFunc2(geom->userPtr,patch.geom,patch.prim,patch.time(),grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
 
-        vfloatx bounds_min_x = pos_inf;
-        vfloatx bounds_min_y = pos_inf;
-        vfloatx bounds_min_z = pos_inf;
-        vfloatx bounds_max_x = neg_inf;
-        vfloatx bounds_max_y = neg_inf;
-        vfloatx bounds_max_z = neg_inf;
-        for (unsigned i = 0; i<grid_size_simd_blocks; i++)
-        {
-          vfloatx x = vfloatx::loadu(&grid_x[i * VSIZEX]);
-          vfloatx y = vfloatx::loadu(&grid_y[i * VSIZEX]);
-          vfloatx z = vfloatx::loadu(&grid_z[i * VSIZEX]);
+      /* set last elements to last displaced point */
+      float* const grid_xyz[3] = { grid_x, grid_y, grid_z };
+      padGrid(grid_xyz,3,dwidth*dheight,grid_size_simd_blocks*VSIZEX);
+    }
 
-	  bounds_min_x = min(bounds_min_x,x);
-	  bounds_min_y = min(bounds_min_y,y);
-	  bounds_min_z = min(bounds_min_z,z);
+    /* eval grid over patch, the tessellation cache file is consulted first when present */
+    void evalGrid(const SubdivPatch1Base& patch,
+                  const unsigned x0, const unsigned x1,
+                  const unsigned y0, const unsigned y1,
+                  const unsigned swidth, const unsigned sheight,
+                  float *__restrict__ const grid_x,
+                  float *__restrict__ const grid_y,
+                  float *__restrict__ const grid_z,
+                  float *__restrict__ const grid_u,
+                  float *__restrict__ const grid_v,
+                  const SubdivMesh* const geom)
+    {
+      TessellationCacheFile* file = geom->parent->device->tessellation_cache_file.get();
+      if (likely(file == nullptr)) {
+        evalGridDirect(patch,x0,x1,y0,y1,swidth,sheight,grid_x,grid_y,grid_z,grid_u,grid_v,geom);
+        return;
+      }
 
-	  bounds_max_x = max(bounds_max_x,x);
-	  bounds_max_y = max(bounds_max_y,y);
-	  bounds_max_z = max(bounds_max_z,z);
-        }
+      const unsigned dwidth  = x1-x0+1;
+      const unsigned dheight = y1-y0+1;
+      const unsigned M = dwidth*dheight+VSIZEX;
+      const unsigned grid_size_simd_blocks = (M-1)/VSIZEX;
+      float* const grids[5] = { grid_x, grid_y, grid_z, grid_u, grid_v };
+      const TessellationCacheFile::Key key(geom->hash,patch.prim,patch.subPatch(),patch.time(),patch.level,x0,x1,y0,y1,swidth,sheight);
 
-        b.lower.x = reduce_min(bounds_min_x);  
-        b.lower.y = reduce_min(bounds_min_y);
-        b.lower.z = reduce_min(bounds_min_z);
-        b.upper.x = reduce_max(bounds_max_x);
-        b.upper.y = reduce_max(bounds_max_y);
-        b.upper.z = reduce_max(bounds_max_z);
-        b.lower.a = 0;
-        b.upper.a = 0;
-      }
-      else
+      if (file->load(key,grids,5,dwidth*dheight))
       {
-        /* grid_u, grid_v need to be padded as we write with SIMD granularity */
-        gridUVTessellator(patch.level,swidth,sheight,x0,y0,dwidth,dheight,grid_u,grid_v);
-      
-        /* set last elements in u,v array to last valid point */
-        const float last_u = grid_u[dwidth*dheight-1];
-        const float last_v = grid_v[dwidth*dheight-1];
-        for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++) {
-          grid_u[i] = last_u;
-          grid_v[i] = last_v;
+        /* set last elements to last valid point */
+        for (size_t j=0; j<5; j++) {
+          const float last = grids[j][dwidth*dheight-1];
+          for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++)
+            grids[j][i] = last;
         }
+        return;
+      }
 
-        /* stitch edges if necessary */
-        if (unlikely(patch.needsStitching()))
-          stitchUVGrid(patch.level,swidth,sheight,x0,y0,dwidth,dheight,grid_u,grid_v);
-      
-        /* iterates over all grid points */
-        Vec3<vfloatx> bounds_min;
-        bounds_min[0] = pos_inf;
-        bounds_min[1] = pos_inf;
-        bounds_min[2] = pos_inf;
-
-        Vec3<vfloatx> bounds_max;
-        bounds_max[0] = neg_inf;
-        bounds_max[1] = neg_inf;
-        bounds_max[2] = neg_inf;
+      evalGridDirect(patch,x0,x1,y0,y1,swidth,sheight,grid_x,grid_y,grid_z,grid_u,grid_v,geom);
+      file->store(key,grids,5,dwidth*dheight);
+    }
 
-        for (unsigned i=0; i<grid_size_simd_blocks; i++)
-        {
-          const vfloatx u = vfloatx::load(&grid_u[i*VSIZEX]);
-          const vfloatx v = vfloatx::load(&grid_v[i*VSIZEX]);
-          Vec3<vfloatx> vtx = patchEval(patch,u,v);
-        
-          /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
-          {
-            const Vec3<vfloatx> normal = normalize_safe(patchNormal(patch,u,v));
-            geom->displFunc(geom->userPtr,patch.geom,patch.prim,
-                            &u[0],&v[0],&normal.x[0],&normal.y[0],&normal.z[0],
-                            &vtx.x[0],&vtx.y[0],&vtx.z[0],VSIZEX);
-          
-          }
-          else if (unlikely(geom->displFunc2 != nullptr))
-          {
-            const Vec3<vfloatx> normal = normalize_safe(patchNormal(patch,u,v));
-            geom->displFunc2(geom->userPtr,patch.geom,patch.prim,patch.time(),
-                            &u[0],&v[0],&normal.x[0],&normal.y[0],&normal.z[0],
-                            &vtx.x[0],&vtx.y[0],&vtx.z[0],VSIZEX);
-          }
+    /* eval grid over patch and stich edges when required */      
+    BBox3fa evalGridBounds(const SubdivPatch1Base& patch,
+                           const unsigned x0, const unsigned x1,
+                           const unsigned y0, const unsigned y1,
+                           const unsigned swidth, const unsigned sheight,
+                           const SubdivMesh* const geom)
+    {
+      const unsigned dwidth  = x1-x0+1;
+      const unsigned dheight = y1-y0+1;
+      const unsigned M = dwidth*dheight+VSIZEX;
+      const unsigned grid_size_simd_blocks = (M-1)/VSIZEX;
+      dynamic_large_stack_array(float,grid_x,M,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_y,M,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_z,M,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_u,M,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_v,M,64*64*sizeof(float));
 
-          bounds_min[0] = min(bounds_min[0],vtx.x);
-          bounds_max[0] = max(bounds_max[0],vtx.x);
-          bounds_min[1] = min(bounds_min[1],vtx.y);
-          bounds_max[1] = max(bounds_max[1],vtx.y);
-          bounds_min[2] = min(bounds_min[2],vtx.z);
-          bounds_max[2] = max(bounds_max[2],vtx.z);      
-        }
+      /* evaluates the complete grid, which also stores it into the
+       * tessellation cache file such that later grid builds and renders
+       * of other processes find it there */
+      evalGrid(patch,x0,x1,y0,y1,swidth,sheight,grid_x,grid_y,grid_z,grid_u,grid_v,geom);
 
-        b.lower.x = reduce_min(bounds_min[0]);
-        b.lower.y = reduce_min(bounds_min[1]);
-        b.lower.z = reduce_min(bounds_min[2]);
-        b.upper.x = reduce_max(bounds_max[0]);
-        b.upper.y = reduce_max(bounds_max[1]);
-        b.upper.z = reduce_max(bounds_max[2]);
-        b.lower.a = 0;
-        b.upper.a = 0;
+      /* padded elements contain the last valid point */
+      Vec3<vfloatx> bounds_min(pos_inf);
+      Vec3<vfloatx> bounds_max(neg_inf);
+      for (unsigned i=0; i<grid_size_simd_blocks; i++)
+      {
+        const Vec3<vfloatx> vtx(vfloatx::load(&grid_x[i*VSIZEX]),vfloatx::load(&grid_y[i*VSIZEX]),vfloatx::load(&grid_z[i*VSIZEX]));
+        bounds_min = min(bounds_min,vtx);
+        bounds_max = max(bounds_max,vtx);
       }
 
+      BBox3fa b;
+      b.lower.x = reduce_min(bounds_min.x);
+      b.lower.y = reduce_min(bounds_min.y);
+      b.lower.z = reduce_min(bounds_min.z);
+      b.upper.x = reduce_max(bounds_max.x);
+      b.upper.y = reduce_max(bounds_max.y);
+      b.upper.z = reduce_max(bounds_max.z);
+      b.lower.a = 0;
+      b.upper.a = 0;
+
       assert( std::isfinite(b.lower.x) );
       assert( std::isfinite(b.lower.y) );
       assert( std::isfinite(b.lower.z) );
@@ -377,5 +385,139 @@ namespace embree
       assert(b.lower.z <= b.upper.z);
       return b;
     }
+
+    bool GridBatch::enabled(const SubdivMesh* geom) {
+      return geom->displBatchFunc != nullptr && geom->parent->device->tessellation_cache_file == nullptr;
+    }
+
+    size_t GridBatch::add(const SubdivPatch1Base& patch, const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight)
+    {
+      Grid grid;
+      grid.patch = &patch;
+      grid.x0 = x0; grid.x1 = x1;
+      grid.y0 = y0; grid.y1 = y1;
+      grid.swidth = swidth; grid.sheight = sheight;
+      grid.begin = unsigned(numPoints);
+      grids.push_back(grid);
+
+      /* each grid starts 64 bytes aligned and has space for SIMD padding */
+      const size_t N = (x1-x0+1)*(y1-y0+1);
+      numPoints += (N+VSIZEX+15) & size_t(-16);
+      return grids.size()-1;
+    }
+
+    void GridBatch::eval()
+    {
+      if (grids.size() == 0)
+        return;
+
+      if (dataPoints < numPoints) {
+        alignedFree(data);
+        data = (float*) alignedMalloc(NUM_ARRAYS*numPoints*sizeof(float),64);
+        dataPoints = numPoints;
+      }
+
+      /* evaluate positions and tangents of all grids */
+      for (size_t i=0; i<grids.size(); i++)
+      {
+        const Grid& g = grids[i];
+        const size_t end = i+1 < grids.size() ? grids[i+1].begin : numPoints;
+        float* grid[NUM_ARRAYS];
+        for (size_t j=0; j<NUM_ARRAYS; j++) grid[j] = array(j) + g.begin;
+        evalGridBase(*g.patch,g.x0,g.x1,g.y0,g.y1,g.swidth,g.sheight,
+                     grid[PX],grid[PY],grid[PZ],grid[U],grid[V],
+                     grid[DUX],grid[DUY],grid[DUZ],grid[DVX],grid[DVY],grid[DVZ],geom);
+        const unsigned N = (g.x1-g.x0+1)*(g.y1-g.y0+1);
+        padGrid(grid,NUM_ARRAYS,N,unsigned(end-g.begin));
+      }
+      
+      /* calculate normals of all grids at once */
+      for (size_t i=0; i<numPoints; i+=VSIZEX)
+      {
+        const Vec3<vfloatx> dPdu(vfloatx::load(&array(DUX)[i]),vfloatx::load(&array(DUY)[i]),vfloatx::load(&array(DUZ)[i]));
+        const Vec3<vfloatx> dPdv(vfloatx::load(&array(DVX)[i]),vfloatx::load(&array(DVY)[i]),vfloatx::load(&array(DVZ)[i]));
+        const Vec3<vfloatx> Ng = normalize_safe(cross(dPdv,dPdu));
+        vfloatx::store(&array(NX)[i],Ng.x);
+        vfloatx::store(&array(NY)[i],Ng.y);
+        vfloatx::store(&array(NZ)[i],Ng.z);
+      }
+
+      /* call displacement shader once for all grids */
+      std::vector<RTCDisplacementGrid> displGrids(grids.size());
+      for (size_t i=0; i<grids.size(); i++) 
+      {
+        displGrids[i].primID = grids[i].patch->prim;
+        displGrids[i].time   = grids[i].patch->time();
+        displGrids[i].begin  = grids[i].begin;
+        displGrids[i].N      = (grids[i].x1-grids[i].x0+1)*(grids[i].y1-grids[i].y0+1);
+      }
+
+      RTCDisplacementBatch batch;
+      batch.geomID = geom->id;
+      batch.numGrids = unsigned(displGrids.size());
+      batch.grids = displGrids.data();
+      batch.numPoints = numPoints;
+      batch.u = array(U);
+      batch.v = array(V);
+      batch.nx = array(NX);
+      batch.ny = array(NY);
+      batch.nz = array(NZ);
+      batch.dPdux = array(DUX);
+      batch.dPduy = array(DUY);
+      batch.dPduz = array(DUZ);
+      batch.dPdvx = array(DVX);
+      batch.dPdvy = array(DVY);
+      batch.dPdvz = array(DVZ);
+      batch.px = array(PX);
+      batch.py = array(PY);
+      batch.pz = array(PZ);
+      geom->displBatchFunc(geom->userPtr,&batch);
+
+      /* outputs in the padding are ignored */
+      for (size_t i=0; i<grids.size(); i++) 
+      {
+        const size_t end = i+1 < grids.size() ? grids[i+1].begin : numPoints;
+        float* const grid_xyz[3] = { array(PX)+grids[i].begin, array(PY)+grids[i].begin, array(PZ)+grids[i].begin };
+        padGrid(grid_xyz,3,displGrids[i].N,unsigned(end-grids[i].begin));
+      }
+    }
+
+    void GridBatch::get(size_t i, const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1,
+                        float* grid_x, float* grid_y, float* grid_z, float* grid_u, float* grid_v) const
+    {
+      const Grid& g = grids[i];
+      assert(g.x0 <= x0 && x1 <= g.x1);
+      assert(g.y0 <= y0 && y1 <= g.y1);
+      const unsigned gwidth = g.x1-g.x0+1;
+      const unsigned dwidth = x1-x0+1;
+      const unsigned dheight = y1-y0+1;
+      const unsigned M = dwidth*dheight+VSIZEX;
+      const unsigned grid_size_simd_blocks = (M-1)/VSIZEX;
+
+      const float* const src[5] = { array(PX), array(PY), array(PZ), array(U), array(V) };
+      float* const dst[5] = { grid_x, grid_y, grid_z, grid_u, grid_v };
+      for (size_t j=0; j<5; j++) {
+        for (unsigned y=0; y<dheight; y++) {
+          const float* const line = src[j] + g.begin + (y0-g.y0+y)*gwidth + (x0-g.x0);
+          memcpy(dst[j]+y*dwidth,line,dwidth*sizeof(float));
+        }
+      }
+      padGrid(dst,5,dwidth*dheight,grid_size_simd_blocks*VSIZEX);
+    }
+
+    BBox3fa GridBatch::bounds(size_t i) const
+    {
+      const Grid& g = grids[i];
+      const size_t N = (g.x1-g.x0+1)*(g.y1-g.y0+1);
+      const float* const px = array(PX) + g.begin;
+      const float* const py = array(PY) + g.begin;
+      const float* const pz = array(PZ) + g.begin;
+      BBox3fa b(empty);
+      for (size_t j=0; j<N; j++)
+        b.extend(Vec3fa(px[j],py[j],pz[j]));
+      b.lower.a = 0;
+      b.upper.a = 0;
+      return b;
+    }
   }
 }
@@ -16,8 +16,24 @@
 
 #include "tessellation_cache.h"
 
+/* number of spin iterations after which waiting threads yield their time slice */
+#define LOOP_YIELD_THRESHOLD 256
+
 namespace embree
 {
+  /* spins until the condition holds, yields from time to time to not starve the threads we wait for */
+  template<typename Condition>
+    static __forceinline void spinWait(const Condition& condition)
+  {
+    for (size_t loopIndex=0; !condition(); loopIndex++)
+    {
+      if ((loopIndex % LOOP_YIELD_THRESHOLD) == LOOP_YIELD_THRESHOLD-1)
+        yield();
+      else
+        _mm_pause();
+    }
+  }
+
   SharedLazyTessellationCache SharedLazyTessellationCache::sharedLazyTessellationCache;
 
   __thread ThreadWorkState* SharedLazyTessellationCache::init_t_state = nullptr;
@@ -45,6 +61,7 @@ namespace embree
     localTime              = NUM_CACHE_SEGMENTS;
     next_block             = 0;
     numRenderThreads       = 0;
+    blocked                = false;
 #if FORCE_SIMPLE_FLUSH == 1
     switch_block_threshold = maxBlocks;
 #else
@@ -81,17 +98,17 @@ namespace embree
     linkedlist_mtx.unlock();
   }
 
-  void SharedLazyTessellationCache::waitForUsersLessEqual(ThreadWorkState *const t_state,
-							  const unsigned int users)
-   {
-     while( !(t_state->counter <= users) )
-     {
-       _mm_pause();
-       _mm_pause();
-       _mm_pause();
-       _mm_pause();
-     }
-   }
+  void SharedLazyTessellationCache::waitForUsersOlderThan(const size_t time)
+  {
+    forEachThreadState([&] (ThreadWorkState* t) {
+        spinWait([&] { return t->epoch.load() >= time; });
+      });
+  }
+
+  void SharedLazyTessellationCache::waitWhileBlocked()
+  {
+    spinWait([&] { return !blocked.load(); });
+  }
 
   void SharedLazyTessellationCache::allocNextSegment() 
   {
@@ -99,19 +116,22 @@ namespace embree
       {
 	if (next_block >= switch_block_threshold)
 	  {
-            /* lock the linked list of thread states */
-
-            linkedlist_mtx.lock();
-
-            /* block all threads */
-	    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-	      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-		waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+            /* let all allocations fail until the next segment is ready */
+            switch_block_threshold = 0;
 
-            /* switch to the next segment */
+            /* advance time, lookups do no longer consider the segment to recycle as valid */
 	    addCurrentIndex();
 	    CACHE_STATS(PRINT("RESET TESS CACHE"));
 
+            /* wait for threads that may still reference the segment to recycle, usually 
+             * there are none as these threads entered before the previous segment switch */
+#if FORCE_SIMPLE_FLUSH == 1
+            waitForUsersOlderThan(localTime);
+#else
+            waitForUsersOlderThan(localTime-1);
+#endif
+
+            /* switch to the next segment */
 #if FORCE_SIMPLE_FLUSH == 1
 	    next_block = 0;
 	    switch_block_threshold = maxBlocks;
@@ -122,23 +142,12 @@ namespace embree
 	    assert( switch_block_threshold <= maxBlocks );
 #endif
 
-	    CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
-
-            /* release all blocked threads */
-
-	    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-	      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-
-            /* unlock the linked list of thread states */
-
-            linkedlist_mtx.unlock();
-	    
-
+	    SharedTessellationCacheStats::cache_flushes++;
 	  }
 	reset_state.unlock();
       }
     else
-      reset_state.wait_until_unlocked();	   
+      spinWait([&] { return !reset_state.isLocked(); });
   }
 
 
@@ -147,13 +156,9 @@ namespace embree
     /* lock the reset_state */
     reset_state.lock();
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
-
     /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+    blocked = true;
+    waitForUsersOlderThan(ThreadWorkState::IDLE);
 
     /* reset to the first segment */
     next_block = 0;
@@ -167,11 +172,7 @@ namespace embree
     localTime = NUM_CACHE_SEGMENTS;
 
     /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    blocked = false;
 
     /* unlock the reset_state */
     reset_state.unlock();
@@ -182,13 +183,9 @@ namespace embree
     /* lock the reset_state */
     reset_state.lock();
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
-
     /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+    blocked = true;
+    waitForUsersOlderThan(ThreadWorkState::IDLE);
 
     /* reallocate data */
     if (data) os_free(data,size);
@@ -212,11 +209,7 @@ namespace embree
 #endif
 
     /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    blocked = false;
 
     /* unlock the reset_state */
     reset_state.unlock();
@@ -227,22 +220,42 @@ namespace embree
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  std::atomic<size_t> SharedTessellationCacheStats::cache_accesses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_hits(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_misses(0);
   std::atomic<size_t> SharedTessellationCacheStats::cache_flushes(0);  
   SpinLock   SharedTessellationCacheStats::mtx;  
   std::atomic<size_t> *SharedTessellationCacheStats::cache_patch_builds(nullptr);
   size_t SharedTessellationCacheStats::cache_num_patches(0);
 
+  std::vector<SharedTessellationCacheStats::ThreadStats> SharedTessellationCacheStats::getThreadStats()
+  {
+    std::vector<ThreadStats> stats;
+    SharedLazyTessellationCache::sharedLazyTessellationCache.forEachThreadState([&] (ThreadWorkState* t) {
+        ThreadStats s;
+        s.hits      = t->hits.load(std::memory_order_relaxed);
+        s.misses    = t->misses.load(std::memory_order_relaxed);
+        s.evictions = t->evictions.load(std::memory_order_relaxed);
+        stats.push_back(s);
+      });
+    return stats;
+  }
+
   void SharedTessellationCacheStats::printStats()
   {
+    size_t cache_hits = 0, cache_misses = 0, cache_evictions = 0;
+    std::vector<ThreadStats> stats = getThreadStats();
+    for (size_t i=0; i<stats.size(); i++) 
+    {
+      std::cout << "  thread " << i << ": hits = " << stats[i].hits << ", misses = " << stats[i].misses << ", evictions = " << stats[i].evictions << std::endl;
+      cache_hits      += stats[i].hits;
+      cache_misses    += stats[i].misses;
+      cache_evictions += stats[i].evictions;
+    }
+    const size_t cache_accesses = cache_hits + cache_misses + cache_evictions;
     PRINT(cache_accesses);
     PRINT(cache_misses);
+    PRINT(cache_evictions);
     PRINT(cache_hits);
     PRINT(cache_flushes);
     PRINT(100.0f * cache_hits / cache_accesses);
-    assert(cache_hits + cache_misses == cache_accesses);
     PRINT(cache_num_patches);
     size_t patches = 0;
     size_t builds  = 0;
@@ -259,10 +272,12 @@ namespace embree
 
   void SharedTessellationCacheStats::clearStats()
   {
-    SharedTessellationCacheStats::cache_accesses  = 0;
-    SharedTessellationCacheStats::cache_hits      = 0;
-    SharedTessellationCacheStats::cache_misses    = 0;
     SharedTessellationCacheStats::cache_flushes   = 0;
+    SharedLazyTessellationCache::sharedLazyTessellationCache.forEachThreadState([&] (ThreadWorkState* t) {
+        t->hits = 0;
+        t->misses = 0;
+        t->evictions = 0;
+      });
     for (size_t i=0;i<cache_num_patches;i++)
       cache_patch_builds[i] = 0;
   }
@@ -291,6 +306,7 @@ namespace embree
     std::atomic<size_t> numFailed;
     std::atomic<int> threadIDCounter;
     static const size_t numEntries = 4*1024;
+    static const size_t numLookups = 100000;
     SharedLazyTessellationCache::CacheEntry entry[numEntries];
 
     cache_regression_test() 
@@ -305,7 +321,7 @@ namespace embree
       size_t maxN = SharedLazyTessellationCache::sharedLazyTessellationCache.maxAllocSize()/4;
       This->barrier.wait();
 
-      for (size_t j=0; j<100000; j++)
+      for (size_t j=0; j<numLookups; j++)
       {
         size_t elt = (threadID+j)%numEntries;
         size_t N = min(1+10*(elt%1000),maxN);
@@ -335,9 +351,18 @@ namespace embree
       This->barrier.wait();
     }
     
+    static size_t numAccesses()
+    {
+      size_t N = 0;
+      for (auto& s : SharedTessellationCacheStats::getThreadStats())
+        N += s.hits + s.misses + s.evictions;
+      return N;
+    }
+
     bool run ()
     {
       numFailed.store(0);
+      const size_t numAccesses0 = numAccesses();
 
       size_t numThreads = getNumberOfLogicalThreads();
       barrier.init(numThreads+1);
@@ -355,6 +380,10 @@ namespace embree
       for (size_t i=0; i<numThreads; i++)
         join(threads[i]);
 
+      /* each lookup is either a hit, a miss, or an eviction */
+      if (numAccesses()-numAccesses0 != numThreads*numLookups)
+        numFailed++;
+
       return numFailed == 0;
     }
   };
@@ -21,8 +21,6 @@
 /* force a complete cache invalidation when running out of allocation space */
 #define FORCE_SIMPLE_FLUSH 0
 
-#define THREAD_BLOCK_ATOMIC_ADD 4
-
 #if defined(DEBUG)
 #define CACHE_STATS(x) 
 #else
@@ -34,15 +32,24 @@ namespace embree
   class SharedTessellationCacheStats
   {
   public:
+
+    /*! statistics of a single render thread */
+    struct ThreadStats
+    {
+      size_t hits;       //!< lookups that found a valid cache entry
+      size_t misses;     //!< lookups that built a cache entry for the first time
+      size_t evictions;  //!< lookups that rebuilt a cache entry whose segment got recycled
+    };
+
     /* stats */
-    static std::atomic<size_t> cache_accesses;
-    static std::atomic<size_t> cache_hits;
-    static std::atomic<size_t> cache_misses;
     static std::atomic<size_t> cache_flushes;                
     static std::atomic<size_t> *cache_patch_builds;                
     static size_t        cache_num_patches;
     __aligned(64) static SpinLock mtx;
     
+    /* returns the statistics of each thread that used the cache */
+    static std::vector<ThreadStats> getThreadStats();
+
     /* print stats for debugging */                 
     static void printStats();
     static void clearStats();
@@ -60,15 +67,29 @@ namespace embree
  {
    ALIGNED_STRUCT;
 
-   std::atomic<size_t> counter;
+   /* epoch of threads that hold no reference into the cache */
+   static const size_t IDLE = -1;
+
+   std::atomic<size_t> counter; //!< number of references into the cache held by the thread
+   std::atomic<size_t> epoch;   //!< cache time when the thread acquired its first reference, or IDLE
    ThreadWorkState* next;
    bool allocated;
 
+   /* statistics, only written by the owning thread */
+   std::atomic<size_t> hits;
+   std::atomic<size_t> misses;
+   std::atomic<size_t> evictions;
+
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), epoch(IDLE), next(nullptr), allocated(allocated), hits(0), misses(0), evictions(0)
    {
      assert( ((size_t)this % 64) == 0 ); 
    }   
+
+   /* increments a statistics counter without a locked instruction */
+   static __forceinline void inc(std::atomic<size_t>& c) {
+     c.store(c.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+   }
  };
 
  class __aligned(64) SharedLazyTessellationCache 
@@ -154,6 +175,7 @@ namespace embree
    __aligned(64) SpinLock   linkedlist_mtx;
    __aligned(64) std::atomic<size_t> switch_block_threshold;
    __aligned(64) std::atomic<size_t> numRenderThreads;
+   __aligned(64) std::atomic<bool> blocked;
 
 
  public:
@@ -164,8 +186,17 @@ namespace embree
 
    void getNextRenderThreadWorkState();
 
+   /* number of blocks of a cache segment */
+   __forceinline size_t segmentBlocks() const {
+#if FORCE_SIMPLE_FLUSH == 1
+     return maxBlocks;
+#else
+     return maxBlocks/NUM_CACHE_SEGMENTS;
+#endif
+   }
+
    __forceinline size_t maxAllocSize() const {
-     return switch_block_threshold;
+     return segmentBlocks();
    }
 
    __forceinline size_t getCurrentIndex() { return localTime.load(); }
@@ -176,8 +207,23 @@ namespace embree
    }
 
 
-   __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) { return t_state->counter.fetch_add(plus);  }
-   __forceinline size_t unlockThread(ThreadWorkState *const t_state, const ssize_t plus=-1) { assert(isLocked(t_state)); return t_state->counter.fetch_add(plus); }
+   /* Threads announce the cache time at which they acquire their
+    * first reference into the cache. A segment gets only recycled once
+    * all threads that could still reference it released their
+    * references, thus threads never block each other when entering
+    * the cache. */
+   __forceinline void lockThread (ThreadWorkState *const t_state) 
+   {
+     if (t_state->counter.fetch_add(1) == 0)
+       t_state->epoch.store(localTime.load());
+   }
+
+   __forceinline void unlockThread (ThreadWorkState *const t_state) 
+   {
+     assert(isLocked(t_state));
+     if (t_state->counter.fetch_sub(1) == 1)
+       t_state->epoch.store(ThreadWorkState::IDLE);
+   }
 
    __forceinline bool isLocked(ThreadWorkState *const t_state) { return t_state->counter.load() != 0; }
 
@@ -191,27 +237,31 @@ namespace embree
      return sharedLazyTessellationCache.getTime(globalTime);
    }
 
-   /* per thread lock */
+   /* per thread lock, only waits while the cache gets resized or reset */
    __forceinline void lockThreadLoop (ThreadWorkState *const t_state) 
    { 
      while(1)
      {
-       size_t lock = SharedLazyTessellationCache::sharedLazyTessellationCache.lockThread(t_state,1);
-       if (unlikely(lock >= THREAD_BLOCK_ATOMIC_ADD))
-       {
-         /* lock failed wait until sync phase is over */
-         sharedLazyTessellationCache.unlockThread(t_state,-1);	       
-         sharedLazyTessellationCache.waitForUsersLessEqual(t_state,0);
-       }
-       else
-         break;
+       lockThread(t_state);
+       if (likely(!blocked.load()) || t_state->counter.load() > 1) break;
+       unlockThread(t_state);
+       waitWhileBlocked();
      }
    }
 
+   /* calls the closure for the state of each render thread */
+   template<typename Closure>
+     void forEachThreadState(const Closure& closure)
+   {
+     linkedlist_mtx.lock();
+     for (ThreadWorkState *t=current_t_state; t!=nullptr; t=t->next)
+       closure(t);
+     linkedlist_mtx.unlock();
+   }
+
    static __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
    {   
      const int64_t subdiv_patch_root_ref = entry.tag.get(); 
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      
      if (likely(subdiv_patch_root_ref != 0)) 
      {
@@ -219,17 +269,13 @@ namespace embree
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
        
        if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
-       {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
          return (void*) subdiv_patch_root;
-       }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return nullptr;
    }
 
    template<typename Constructor>
-     static __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor, const bool before=false) -> decltype(constructor())
+     static __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor) -> decltype(constructor())
    {
      ThreadWorkState *t_state = SharedLazyTessellationCache::threadState();
 
@@ -237,18 +283,22 @@ namespace embree
      {
        sharedLazyTessellationCache.lockThreadLoop(t_state);
        void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       if (patch) {
+         ThreadWorkState::inc(t_state->hits);
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
-           auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
+           ThreadWorkState::inc(entry.tag.get() ? t_state->evictions : t_state->misses);
+           /* the entry is tagged with the time before construction, as
+            * its memory never stems from an older segment than that */
+           auto time = sharedLazyTessellationCache.getTime(globalTime);
            auto ret = constructor(); // thread is locked here!
            assert(ret);
            /* this should never return nullptr */
-           auto timeAfter = sharedLazyTessellationCache.getTime(globalTime);
-           auto time = before ? timeBefore : timeAfter;
            __memory_barrier();
            entry.tag = SharedLazyTessellationCache::Tag(ret,time);
            __memory_barrier();
@@ -261,18 +311,22 @@ namespace embree
      }
    }
    
+   /* Entries of the most recent NUM_CACHE_SEGMENTS-1 segments are
+    * valid, the oldest segment is kept invalid such that it can get
+    * recycled without waiting for threads that entered the cache
+    * after the previous segment switch. */
    __forceinline bool validCacheIndex(const size_t i, const size_t globalTime)
    {
 #if FORCE_SIMPLE_FLUSH == 1
      return i == getTime(globalTime);
 #else
-     return i+(NUM_CACHE_SEGMENTS-1) >= getTime(globalTime);
+     return i+(NUM_CACHE_SEGMENTS-2) >= getTime(globalTime);
 #endif
    }
 
    static __forceinline bool validTime(const size_t oldtime, const size_t newTime)
    {
-     return oldtime+(NUM_CACHE_SEGMENTS-1) >= newTime;
+     return oldtime+(NUM_CACHE_SEGMENTS-2) >= newTime;
    }
 
 
@@ -284,15 +338,17 @@ namespace embree
       return sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime);
     }
 
-   void waitForUsersLessEqual(ThreadWorkState *const t_state,
-			      const unsigned int users);
+   /* waits until no thread holds references acquired before the specified time */
+   void waitForUsersOlderThan(const size_t time);
+
+   /* waits until the cache got resized or reset */
+   void waitWhileBlocked();
     
    __forceinline size_t alloc(const size_t blocks)
    {
-     if (unlikely(blocks >= switch_block_threshold))
+     if (unlikely(blocks >= segmentBlocks()))
        throw_RTCError(RTC_INVALID_OPERATION,"allocation exceeds size of tessellation cache segment");
 
-     assert(blocks < switch_block_threshold);
      size_t index = next_block.fetch_add(blocks);
      if (unlikely(index + blocks >= switch_block_threshold)) return (size_t)-1;
      return index;
@@ -307,9 +363,17 @@ namespace embree
        block_index = sharedLazyTessellationCache.alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
        if (block_index == (size_t)-1)
        {
-         sharedLazyTessellationCache.unlockThread(t_state);		  
+         sharedLazyTessellationCache.unlockThread(t_state);
+
+         /* a thread that is still locked constructs a nested entry
+          * (e.g. a patch of the grid it builds), it must not delay the
+          * segment switch it waits for itself */
+         const size_t epoch = t_state->epoch.load();
+         if (epoch != ThreadWorkState::IDLE) t_state->epoch.store(ThreadWorkState::IDLE);
          sharedLazyTessellationCache.allocNextSegment();
-         sharedLazyTessellationCache.lockThread(t_state);
+         if (epoch != ThreadWorkState::IDLE) t_state->epoch.store(epoch);
+
+         sharedLazyTessellationCache.lockThreadLoop(t_state);
          continue; 
        }
        break;
@@ -0,0 +1,112 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "tessellation_cache_file.h"
+
+namespace embree
+{
+  const char* TessellationCacheFile::magic = "EMBRTC01";
+
+  TessellationCacheFile::TessellationCacheFile (const std::string& fileName, size_t maxBytes)
+    : fileName(fileName), ptr(nullptr), maxBytes(maxBytes), hits(0), misses(0), stores(0)
+  {
+    if (maxBytes < sizeof(Header))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"tessellation cache file size too small");
+
+    ptr = (char*) os_map_file(fileName.c_str(),maxBytes);
+    if (ptr == nullptr)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"cannot open tessellation cache file "+fileName);
+
+    initIndex();
+  }
+
+  TessellationCacheFile::~TessellationCacheFile () {
+    os_unmap_file(ptr,maxBytes);
+  }
+
+  void TessellationCacheFile::initIndex()
+  {
+    /* start with an empty file if the format does not match */
+    Header* header = (Header*) ptr;
+    if (memcmp(header->magic,magic,sizeof(header->magic)) != 0 || header->bytes < sizeof(Header)) {
+      header->bytes = sizeof(Header);
+      memcpy(header->magic,magic,sizeof(header->magic));
+    }
+
+    /* index all records that fit into the mapped part of the file */
+    size_t offset = sizeof(Header);
+    while (offset < header->bytes)
+    {
+      const Record* record = (const Record*) &ptr[offset];
+      const size_t next = (offset+sizeof(Record)+record->bytes+15) & ~size_t(15);
+      if (offset+sizeof(Record) > maxBytes || next > maxBytes || next > header->bytes) break;
+      index[record->key] = offset;
+      offset = next;
+    }
+    header->bytes = offset;
+  }
+
+  bool TessellationCacheFile::load(const Key& key, float* const* grids, size_t N, size_t numVertices)
+  {
+    size_t offset = 0;
+    {
+      Lock<MutexSys> lock(mutex);
+      auto i = index.find(key);
+      if (i != index.end()) offset = i->second;
+    }
+    if (offset == 0 || ((const Record*) &ptr[offset])->bytes != N*numVertices*sizeof(float)) {
+      misses++;
+      return false;
+    }
+
+    /* stored records never change, thus can get copied without holding the lock */
+    const float* data = (const float*) &ptr[offset+sizeof(Record)];
+    for (size_t i=0; i<N; i++)
+      memcpy(grids[i],&data[i*numVertices],numVertices*sizeof(float));
+    hits++;
+    return true;
+  }
+
+  void TessellationCacheFile::store(const Key& key, const float* const* grids, size_t N, size_t numVertices)
+  {
+    Lock<MutexSys> lock(mutex);
+    if (index.find(key) != index.end()) return;
+
+    /* ignore the grid when the file is full */
+    Header* header = (Header*) ptr;
+    const size_t offset = header->bytes;
+    const size_t bytes = N*numVertices*sizeof(float);
+    const size_t next = (offset+sizeof(Record)+bytes+15) & ~size_t(15);
+    if (next > maxBytes) return;
+
+    /* write the record before publishing it in the header */
+    new (&ptr[offset]) Record(key,bytes);
+    float* data = (float*) &ptr[offset+sizeof(Record)];
+    for (size_t i=0; i<N; i++)
+      memcpy(&data[i*numVertices],grids[i],numVertices*sizeof(float));
+    __memory_barrier();
+    header->bytes = next;
+    index[key] = offset;
+    stores++;
+  }
+
+  void TessellationCacheFile::print()
+  {
+    std::cout << "tessellation cache file " << fileName << ": "
+              << index.size() << " grids, " << ((Header*)ptr)->bytes << " of " << maxBytes << " bytes used, "
+              << hits << " hits, " << misses << " misses, " << stores << " stores" << std::endl;
+  }
+}
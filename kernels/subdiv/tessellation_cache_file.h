@@ -0,0 +1,113 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../common/default.h"
+
+namespace embree
+{
+  /*! 64 bit FNV-1a hash, identifies mesh data across processes */
+  __forceinline uint64_t hashBytes(const void* ptr, const size_t bytes, uint64_t hash = 0xcbf29ce484222325ull)
+  {
+    const unsigned char* p = (const unsigned char*) ptr;
+    for (size_t i=0; i<bytes; i++) {
+      hash ^= p[i];
+      hash *= 0x100000001b3ull;
+    }
+    return hash;
+  }
+
+  /*! Persistent second level of the tessellation cache. Stores the
+   *  evaluated vertex grids of subdivision patches in a memory mapped
+   *  file, such that later renders of the same mesh, also by other
+   *  processes, skip grid evaluation including the displacement
+   *  function. The file is append only, once it is full new grids
+   *  are no longer stored. */
+  class TessellationCacheFile
+  {
+  public:
+
+    /*! identifies the grid of some patch */
+    struct Key
+    {
+      Key (uint64_t mesh, unsigned prim, unsigned subPatch, unsigned time, const float level[4],
+           unsigned x0, unsigned x1, unsigned y0, unsigned y1, unsigned swidth, unsigned sheight)
+        : mesh(mesh), prim(prim), subPatch(subPatch), time(time),
+          x0((unsigned short)x0), x1((unsigned short)x1), y0((unsigned short)y0), y1((unsigned short)y1),
+          swidth((unsigned short)swidth), sheight((unsigned short)sheight)
+      {
+        for (size_t i=0; i<4; i++) this->level[i] = level[i];
+      }
+
+      __forceinline friend bool operator< (const Key& a, const Key& b) { return memcmp(&a,&b,sizeof(Key)) < 0; }
+      __forceinline friend bool operator==(const Key& a, const Key& b) { return memcmp(&a,&b,sizeof(Key)) == 0; }
+
+    public:
+      uint64_t mesh;       //!< hash of the mesh data
+      unsigned prim;       //!< primitive ID of the patch
+      unsigned subPatch;   //!< sub-patch of non-quad faces
+      unsigned time;       //!< time step of the patch
+      float level[4];      //!< edge levels of the patch
+      unsigned short x0,x1;     //!< evaluated range of the grid
+      unsigned short y0,y1;
+      unsigned short swidth;    //!< resolution of the complete grid
+      unsigned short sheight;
+    };
+
+    TessellationCacheFile (const std::string& fileName, size_t maxBytes);
+    ~TessellationCacheFile ();
+
+    /*! copies the N float arrays of the grid of some patch into grids, returns false if the grid is not stored */
+    bool load(const Key& key, float* const* grids, size_t N, size_t numVertices);
+
+    /*! stores the N float arrays of the grid of some patch */
+    void store(const Key& key, const float* const* grids, size_t N, size_t numVertices);
+
+    /*! prints statistics */
+    void print();
+
+  private:
+
+    struct Header
+    {
+      char magic[8];        //!< identifies the file format
+      uint64_t bytes;       //!< bytes used by the header and all stored grids
+    };
+
+    struct Record
+    {
+      __forceinline Record (const Key& key, uint64_t bytes)
+        : key(key), bytes(bytes) {}
+
+      Key key;
+      uint64_t bytes;       //!< bytes of the grid data following the record
+    };
+
+    static const char* magic;
+
+    /*! rebuilds the index of all grids stored in the file */
+    void initIndex();
+
+  private:
+    std::string fileName;   //!< name of the mapped file
+    char* ptr;              //!< mapped file data
+    size_t maxBytes;        //!< number of mapped bytes
+    MutexSys mutex;         //!< protects the index and allocation of file space
+    std::map<Key,size_t> index;  //!< maps keys to record offsets
+    std::atomic<size_t> hits, misses, stores;
+  };
+}
@@ -21,6 +21,7 @@
 #include "../common/algorithms/parallel_for.h"
 #include <regex>
 #include <stack>
+#include <thread>
 
 #define random  use_random_function_of_test // do use random_int() and random_float() from Test class
 #define drand48 use_random_function_of_test // do use random_int() and random_float() from Test class
@@ -1739,6 +1740,91 @@ namespace embree
     }
   };
 
+
+  struct InterpolateNTest : public VerifyApplication::Test
+  {
+    size_t N;
+    bool quads;
+    
+    InterpolateNTest (std::string name, int isa, size_t N, bool quads)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), N(N), quads(quads) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      RTCSceneRef scene = rtcDeviceNewScene(device,RTC_SCENE_STATIC,RTC_INTERPOLATE);
+      AssertNoError(device);
+      const size_t numPrims = quads ? num_interpolation_quad_faces : num_interpolation_triangle_faces;
+      unsigned int geomID = quads 
+        ? rtcNewQuadMesh    (scene, RTC_GEOMETRY_STATIC, numPrims, num_interpolation_vertices, 1)
+        : rtcNewTriangleMesh(scene, RTC_GEOMETRY_STATIC, numPrims, num_interpolation_vertices, 1);
+      AssertNoError(device);
+      
+      if (quads) rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER, interpolation_quad_indices    , 0, 4*sizeof(unsigned int));
+      else       rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER, interpolation_triangle_indices, 0, 3*sizeof(unsigned int));
+      AssertNoError(device);
+
+      std::vector<Vec3fa> vertices(num_interpolation_vertices);
+      for (size_t i=0; i<num_interpolation_vertices; i++) vertices[i] = Vec3fa(float(i%4),0.0f,float(i/4));
+      rtcSetBuffer(scene, geomID, RTC_VERTEX_BUFFER0, vertices.data(), 0, sizeof(Vec3fa));
+      AssertNoError(device);
+      
+      std::vector<float> user_vertices(num_interpolation_vertices*N+16); // padds the array with some valid data
+      for (size_t i=0; i<user_vertices.size(); i++) user_vertices[i] = random_float();
+      rtcSetBuffer(scene, geomID, RTC_USER_VERTEX_BUFFER0, user_vertices.data(), 0, N*sizeof(float));
+      AssertNoError(device);
+      
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      /* interpolate at random locations, some are disabled and the number is no multiple of the SIMD width */
+      const size_t numUVs = 37;
+      std::vector<int> valid(numUVs);
+      std::vector<unsigned> primIDs(numUVs);
+      std::vector<float> u(numUVs), v(numUVs);
+      for (size_t i=0; i<numUVs; i++) {
+        valid[i] = i%5 == 3 ? 0 : -1;
+        primIDs[i] = unsigned(random_int() % numPrims);
+        u[i] = random_float();
+        v[i] = random_float();
+      }
+
+      bool passed = true;
+      for (size_t j=0; j<2; j++)
+      {
+        const int* pvalid = j == 0 ? valid.data() : nullptr;
+        std::vector<float> P(N*numUVs,-1.0f), dPdu(N*numUVs,-1.0f), dPdv(N*numUVs,-1.0f);
+        std::vector<float> ddPdudu(N*numUVs,-1.0f), ddPdvdv(N*numUVs,-1.0f), ddPdudv(N*numUVs,-1.0f);
+        rtcInterpolateN2(scene,geomID,pvalid,primIDs.data(),u.data(),v.data(),numUVs,RTC_USER_VERTEX_BUFFER0,
+                         P.data(),dPdu.data(),dPdv.data(),ddPdudu.data(),ddPdvdv.data(),ddPdudv.data(),N);
+        AssertNoError(device);
+
+        /* compare against interpolation of single locations, disabled elements have to stay untouched */
+        for (size_t i=0; i<numUVs; i++)
+        {
+          float P1[256], dPdu1[256], dPdv1[256], ddPdudu1[256], ddPdvdv1[256], ddPdudv1[256];
+          rtcInterpolate2(scene,geomID,primIDs[i],u[i],v[i],RTC_USER_VERTEX_BUFFER0,P1,dPdu1,dPdv1,ddPdudu1,ddPdvdv1,ddPdudv1,N);
+          const bool active = !pvalid || pvalid[i];
+          for (size_t k=0; k<N; k++) {
+            const size_t ofs = k*numUVs+i;
+            passed &= fabs((active ? P1[k]       : -1.0f) - P[ofs]      ) < 1E-5f;
+            passed &= fabs((active ? dPdu1[k]    : -1.0f) - dPdu[ofs]   ) < 1E-5f;
+            passed &= fabs((active ? dPdv1[k]    : -1.0f) - dPdv[ofs]   ) < 1E-5f;
+            passed &= fabs((active ? ddPdudu1[k] : -1.0f) - ddPdudu[ofs]) < 1E-5f;
+            passed &= fabs((active ? ddPdvdv1[k] : -1.0f) - ddPdvdv[ofs]) < 1E-5f;
+            passed &= fabs((active ? ddPdudv1[k] : -1.0f) - ddPdudv[ofs]) < 1E-5f;
+          }
+        }
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
@@ -1863,31 +1949,879 @@ namespace embree
         Vec3fa to = vertices[0] + u[i]*(vertices[1]-vertices[0]) + v[i]*(vertices[3]-vertices[0]);
         rays[i] = makeRay(from,to-from);
       }
-      IntersectWithMode(imode,ivariant,scene,rays,256);
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (rays[i].geomID != 0) return VerifyApplication::FAILED;
+        if (ivariant & VARIANT_OCCLUDED) continue;
+        if (rays[i].primID != 0) return VerifyApplication::FAILED;
+        if (abs(rays[i].u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+
+        const Vec3fa org(rays[i].org[0],rays[i].org[1],rays[i].org[2]);
+        const Vec3fa dir(rays[i].dir[0],rays[i].dir[1],rays[i].dir[2]);
+        const Vec3fa ht  = org + rays[i].tfar*dir;
+        const Vec3fa huv = vertices[0] + rays[i].u*(vertices[1]-vertices[0]) + rays[i].v*(vertices[3]-vertices[0]);
+        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2])); // FIXME: some geom normals are scaled!!!??
+        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,-1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct TimeStepsHitTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+    RTCGeometryFlags gflags; 
+
+    TimeStepsHitTest (std::string name, int isa, RTCSceneFlags sflags, RTCGeometryFlags gflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gflags(gflags) {}
+
+    /* depth of the triangle of mesh i at some time, the time steps of the meshes do not fall onto a common grid */
+    static float depth(size_t i, size_t t) { return ((t+i)%2) ? 1.0f : 0.0f; }
+    static size_t numTimeSteps(size_t i) { return i == 0 ? 5 : 7; }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      RTCSceneRef scene = rtcDeviceNewScene(device,sflags,to_aflags(imode));
+      Triangle triangles[1] = { Triangle(0,1,2) };
+      avector<Vec3fa> vertices[2][7];
+      for (size_t i=0; i<2; i++)
+      {
+        int geomID = rtcNewTriangleMesh (scene, gflags, 1, 3, numTimeSteps(i));
+        for (size_t t=0; t<numTimeSteps(i); t++) 
+        {
+          const float x = 2.0f*float(i), z = depth(i,t);
+          vertices[i][t].push_back(Vec3fa(x+0.0f,0.0f,z));
+          vertices[i][t].push_back(Vec3fa(x+1.0f,0.0f,z));
+          vertices[i][t].push_back(Vec3fa(x+0.0f,1.0f,z));
+          rtcSetBuffer(scene, geomID, RTCBufferType(RTC_VERTEX_BUFFER0+t), vertices[i][t].data(), 0, sizeof(Vec3fa));
+        }
+        rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER, triangles, 0, sizeof(Triangle));
+      }
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      float expected[256];
+      RTCRay rays[256];
+      for (size_t j=0; j<256; j++)
+      {
+        const size_t i = j%2;
+        const float time = random_float();
+        const float f = time*float(numTimeSteps(i)-1);
+        const size_t t = min(size_t(f),numTimeSteps(i)-2);
+        expected[j] = 1.0f + lerp(depth(i,t),depth(i,t+1),f-float(t));
+        rays[j] = makeRay(Vec3fa(2.0f*float(i)+0.25f,0.25f,-1.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rays[j].time = time;
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t j=0; j<256; j++)
+      {
+        if (rays[j].geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        if ((ivariant & VARIANT_INTERSECT_OCCLUDED_MASK) == VARIANT_OCCLUDED) continue;
+        if (rays[j].geomID != j%2) return VerifyApplication::FAILED;
+        if (abs(rays[j].tfar - expected[j]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TessellationCamerasTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    TessellationCamerasTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* perspective camera at (0,0,5) with 90 degree field of view looking along -z (or +z to look away from the origin) */
+    static RTCTessellationCamera makeCamera(bool lookAway)
+    {
+      const float s = lookAway ? -1.0f : 1.0f;
+      RTCTessellationCamera camera = {
+        { 1.0f, 0.0f, 0.0f, 0.0f, 
+          0.0f, 1.0f, 0.0f, 0.0f,
+          0.0f, 0.0f, 0.0f, -s, 
+          0.0f, 0.0f, 0.0f, 5.0f*s },
+        512.0f, 512.0f
+      };
+      return camera;
+    }
+
+    static void shoot(RTCScene scene, float* tfar)
+    {
+      for (size_t i=0; i<64; i++) {
+        RTCRay ray = makeRay(Vec3fa(0.0f,0.0f,5.0f),Vec3fa(0.02f*float(i%8)-0.07f,0.02f*float(i/8)-0.07f,-1.0f));
+        rtcIntersect(scene,ray);
+        tfar[i] = ray.geomID == RTC_INVALID_GEOMETRY_ID ? -1.0f : ray.tfar;
+      }
+    }
+
+    static float error(const float* a, const float* b) 
+    {
+      float err = 0.0f;
+      for (size_t i=0; i<64; i++) {
+        if (a[i] < 0.0f || b[i] < 0.0f) return inf;
+        err += abs(a[i]-b[i]);
+      }
+      return err;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      /* reference hit distances for fine and coarse tessellation */
+      float fine[64], coarse[64];
+      {
+        VerifyScene scene(device,sflags,aflags);
+        scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(zero,1.0f,8,64.0f));
+        rtcCommit(scene);
+        AssertNoError(device);
+        shoot(scene,fine);
+      }
+      {
+        VerifyScene scene(device,sflags,aflags);
+        scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(zero,1.0f,8,1.0f));
+        rtcCommit(scene);
+        AssertNoError(device);
+        shoot(scene,coarse);
+      }
+
+      /* the camera looking at the sphere has to tessellate it finely, the camera looking away only coarsely */
+      for (size_t lookAway=0; lookAway<2; lookAway++)
+      {
+        VerifyScene scene(device,sflags,aflags);
+        unsigned geomID = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(zero,1.0f,8,64.0f));
+        const RTCTessellationCamera camera = makeCamera(lookAway);
+        rtcSetTessellationCameras(scene,geomID,&camera,1,1.0f);
+        AssertNoError(device);
+        rtcSetTessellationCameras(scene,geomID,&camera,1,-1.0f);
+        AssertError(device,RTC_INVALID_ARGUMENT);
+        rtcCommit(scene);
+        AssertNoError(device);
+        
+        float tfar[64]; shoot(scene,tfar);
+        if (lookAway && error(tfar,coarse) > 1E-3f) return VerifyApplication::FAILED;
+        if (!lookAway && error(tfar,fine) > 0.25f*error(coarse,fine)) return VerifyApplication::FAILED;
+
+        /* changing the cameras of a dynamic scene retessellates the mesh */
+        if (sflags & RTC_SCENE_DYNAMIC) 
+        {
+          const RTCTessellationCamera camera1 = makeCamera(!lookAway);
+          rtcSetTessellationCameras(scene,geomID,&camera1,1,1.0f);
+          rtcCommit(scene);
+          AssertNoError(device);
+          shoot(scene,tfar);
+          if (!lookAway && error(tfar,coarse) > 1E-3f) return VerifyApplication::FAILED;
+          if (lookAway && error(tfar,fine) > 0.25f*error(coarse,fine)) return VerifyApplication::FAILED;
+        }
+      }
+
+      /* tessellation cameras are only supported by subdivision meshes */
+      {
+        VerifyScene scene(device,sflags,aflags);
+        unsigned geomID = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,8));
+        const RTCTessellationCamera camera = makeCamera(false);
+        rtcSetTessellationCameras(scene,geomID,&camera,1,1.0f);
+        AssertError(device,RTC_INVALID_OPERATION);
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TessellationCacheFileTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    TessellationCacheFileTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* displaces along the normal and counts the displaced vertices */
+    static void displacementFunction(void* ptr, unsigned geomID, unsigned primID, 
+                                     const float* u, const float* v, 
+                                     const float* nx, const float* ny, const float* nz, 
+                                     float* px, float* py, float* pz, size_t N)
+    {
+      *(std::atomic<size_t>*)ptr += N;
+      for (size_t i=0; i<N; i++) {
+        const float d = 0.05f*sin(10.0f*u[i])*cos(10.0f*v[i]);
+        px[i] += d*nx[i]; py[i] += d*ny[i]; pz[i] += d*nz[i];
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      const std::string fileName = "verify_tessellation_cache_"+stringOfISA(isa)+"_"+to_string(sflags)+".bin";
+      remove(fileName.c_str());
+
+      /* the second device finds all grids in the file written by the first device */
+      float tfar[2][64];
+      for (size_t i=0; i<2; i++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",tessellation_cache_file=\""+fileName+"\",tessellation_cache_file_size=64";
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(rtcDeviceGetError(device));
+
+        std::atomic<size_t> numDisplaced(0);
+        {
+          VerifyScene scene(device,sflags,aflags);
+          unsigned geomID = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(zero,1.0f,8,16.0f));
+          RTCBounds bounds = { -0.05f, -0.05f, -0.05f, 0.0f, 0.05f, 0.05f, 0.05f, 0.0f };
+          rtcSetUserData(scene,geomID,&numDisplaced);
+          rtcSetDisplacementFunction(scene,geomID,displacementFunction,&bounds);
+          rtcCommit(scene);
+          AssertNoError(device);
+          TessellationCamerasTest::shoot(scene,tfar[i]);
+        }
+        AssertNoError(device);
+
+        if (i == 0 && numDisplaced == 0) return VerifyApplication::FAILED;
+        if (i == 1 && numDisplaced != 0) return VerifyApplication::FAILED;
+      }
+      remove(fileName.c_str());
+
+      for (size_t j=0; j<64; j++)
+        if (tfar[0][j] != tfar[1][j]) return VerifyApplication::FAILED;
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct DisplacementBatchTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    DisplacementBatchTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    struct BatchStats
+    {
+      BatchStats () : numMultiGridCalls(0), invalid(false) {}
+      std::atomic<size_t> numMultiGridCalls;
+      std::atomic<bool> invalid;
+    };
+
+    /* same displacement as TessellationCacheFileTest::displacementFunction, validates the batch layout and tangents */
+    static void displacementBatchFunction(void* ptr, const RTCDisplacementBatch* batch)
+    {
+      BatchStats* stats = (BatchStats*) ptr;
+      if (batch->numGrids > 1) stats->numMultiGridCalls++;
+      for (size_t g=0; g<batch->numGrids; g++)
+      {
+        const RTCDisplacementGrid& grid = batch->grids[g];
+        if (grid.begin % 16 || grid.begin+grid.N > batch->numPoints) stats->invalid = true;
+        for (size_t i=grid.begin; i<grid.begin+grid.N; i++)
+        {
+          const Vec3fa n(batch->nx[i],batch->ny[i],batch->nz[i]);
+          const Vec3fa dPdu(batch->dPdux[i],batch->dPduy[i],batch->dPduz[i]);
+          const Vec3fa dPdv(batch->dPdvx[i],batch->dPdvy[i],batch->dPdvz[i]);
+          const Vec3fa Ng = cross(dPdv,dPdu);
+          if (length(Ng) > 1E-6f && dot(n,normalize(Ng)) < 0.99f) stats->invalid = true;
+          const float d = 0.05f*sin(10.0f*batch->u[i])*cos(10.0f*batch->v[i]);
+          batch->px[i] += d*n.x; batch->py[i] += d*n.y; batch->pz[i] += d*n.z;
+        }
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      RTCBounds bounds = { -0.05f, -0.05f, -0.05f, 0.0f, 0.05f, 0.05f, 0.05f, 0.0f };
+
+      /* reference hit distances with per patch displacement */
+      float tfar0[64];
+      {
+        std::atomic<size_t> numDisplaced(0);
+        VerifyScene scene(device,sflags,aflags);
+        unsigned geomID = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(zero,1.0f,8,16.0f));
+        rtcSetUserData(scene,geomID,&numDisplaced);
+        rtcSetDisplacementFunction(scene,geomID,TessellationCacheFileTest::displacementFunction,&bounds);
+        rtcCommit(scene);
+        AssertNoError(device);
+        TessellationCamerasTest::shoot(scene,tfar0);
+      }
+
+      /* the batched displacement function gets the grids of multiple patches at once */
+      float tfar1[64];
+      BatchStats stats;
+      {
+        VerifyScene scene(device,sflags,aflags);
+        unsigned geomID = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(zero,1.0f,8,16.0f));
+        rtcSetUserData(scene,geomID,&stats);
+        rtcSetDisplacementBatchFunction(scene,geomID,displacementBatchFunction,&bounds);
+        rtcCommit(scene);
+        AssertNoError(device);
+        TessellationCamerasTest::shoot(scene,tfar1);
+      }
+      AssertNoError(device);
+
+      if (stats.invalid || stats.numMultiGridCalls == 0) return VerifyApplication::FAILED;
+      for (size_t j=0; j<64; j++)
+        if (abs(tfar0[j]-tfar1[j]) > 1E-4f) return VerifyApplication::FAILED;
+
+      /* batched displacement is only supported by subdivision meshes */
+      {
+        VerifyScene scene(device,sflags,aflags);
+        unsigned geomID = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,8));
+        rtcSetDisplacementBatchFunction(scene,geomID,displacementBatchFunction,&bounds);
+        AssertError(device,RTC_INVALID_OPERATION);
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct SubdivTopologyUpdateTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    SubdivTopologyUpdateTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* sphere with a vertex crease at the vertex facing the camera, modification 1 moves some vertices, modification 2 sharpens the crease */
+    static Ref<SceneGraph::SubdivMeshNode> createMesh(size_t numModifications)
+    {
+      Ref<SceneGraph::SubdivMeshNode> mesh = SceneGraph::createSubdivSphere(zero,1.0f,8,16.0f).dynamicCast<SceneGraph::SubdivMeshNode>();
+      mesh->vertex_creases.push_back(4*16);
+      mesh->vertex_crease_weights.push_back(0.0f);
+      modify(mesh,0,numModifications);
+      return mesh;
+    }
+
+    static void modify(Ref<SceneGraph::SubdivMeshNode> mesh, size_t begin, size_t end)
+    {
+      for (size_t i=begin; i<end; i++)
+      {
+        if (i == 0) {
+          for (auto& p : mesh->positions[0])
+            if (p.x > 0.0f && p.z > 0.0f) p = 1.1f*p;
+        }
+        else if (i == 1) 
+          mesh->vertex_crease_weights[0] = 10.0f;
+      }
+    }
+
+    /* shoots the rays of TessellationCamerasTest::shoot and interpolates the hit positions */
+    static void shoot(RTCScene scene, float* tfar, Vec3fa* P)
+    {
+      for (size_t i=0; i<64; i++) {
+        RTCRay ray = makeRay(Vec3fa(0.0f,0.0f,5.0f),Vec3fa(0.02f*float(i%8)-0.07f,0.02f*float(i/8)-0.07f,-1.0f));
+        rtcIntersect(scene,ray);
+        tfar[i] = ray.geomID == RTC_INVALID_GEOMETRY_ID ? -1.0f : ray.tfar;
+        P[i] = Vec3fa(0.0f);
+        if (ray.geomID != RTC_INVALID_GEOMETRY_ID) 
+          rtcInterpolate(scene,ray.geomID,ray.primID,ray.u,ray.v,RTC_VERTEX_BUFFER0,&P[i].x,nullptr,nullptr,3);
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      const RTCAlgorithmFlags iflags = (RTCAlgorithmFlags) (aflags | RTC_INTERPOLATE);
+
+      Ref<SceneGraph::SubdivMeshNode> mesh = createMesh(0);
+      VerifyScene scene(device,sflags,iflags);
+      const RTCGeometryFlags gflags = (sflags & RTC_SCENE_DYNAMIC) ? RTC_GEOMETRY_DEFORMABLE : RTC_GEOMETRY_STATIC;
+      unsigned geomID = scene.addGeometry(gflags,mesh.dynamicCast<SceneGraph::Node>());
+
+      for (size_t i=0; i<3; i++)
+      {
+        /* update the mesh in place, this only modifies the vertex and crease buffers */
+        if (i > 0) 
+        {
+          if (!(sflags & RTC_SCENE_DYNAMIC)) break;
+          modify(mesh,i-1,i);
+          rtcUpdateBuffer(scene,geomID,i == 1 ? RTC_VERTEX_BUFFER0 : RTC_VERTEX_CREASE_WEIGHT_BUFFER);
+        }
+        rtcCommit(scene);
+        AssertNoError(device);
+        float tfar0[64]; Vec3fa P0[64]; 
+        shoot(scene,tfar0,P0);
+
+        /* the updated mesh has to match a newly created mesh */
+        VerifyScene scene1(device,sflags,iflags);
+        scene1.addGeometry(RTC_GEOMETRY_STATIC,createMesh(i).dynamicCast<SceneGraph::Node>());
+        rtcCommit(scene1);
+        AssertNoError(device);
+        float tfar1[64]; Vec3fa P1[64]; 
+        shoot(scene1,tfar1,P1);
+        
+        for (size_t j=0; j<64; j++) {
+          if (tfar0[j] < 0.0f || abs(tfar0[j]-tfar1[j]) > 1E-4f) return VerifyApplication::FAILED;
+          if (length(P0[j]-P1[j]) > 1E-4f) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct SubdivPatchTableTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    SubdivPatchTableTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* hit distances of rays towards the triangle fan at the pole and interpolated user data at 2 locations of each face */
+    struct Result
+    {
+      float tfar[64];
+      std::vector<float> P, dPdu, dPdv, PN;
+    };
+
+    static void evaluate(RTCScene scene, unsigned geomID, size_t numFaces, Result& result)
+    {
+      for (size_t i=0; i<64; i++) {
+        RTCRay ray = makeRay(Vec3fa(0.0f,5.0f,0.0f),Vec3fa(0.02f*float(i%8)-0.07f,-1.0f,0.02f*float(i/8)-0.07f));
+        rtcIntersect(scene,ray);
+        result.tfar[i] = ray.geomID == RTC_INVALID_GEOMETRY_ID ? -1.0f : ray.tfar;
+      }
+      
+      /* the UVs lie inside the first sub-patch of non-quad faces */
+      std::vector<unsigned> primIDs; std::vector<float> us, vs;
+      for (size_t f=0; f<numFaces; f++) {
+        primIDs.push_back(unsigned(f)); us.push_back(0.1f); vs.push_back(0.2f);
+        primIDs.push_back(unsigned(f)); us.push_back(0.2f); vs.push_back(0.05f);
+      }
+      const size_t N = primIDs.size();
+      result.P.resize(7*N); result.dPdu.resize(7*N); result.dPdv.resize(7*N); result.PN.resize(7*N);
+      for (size_t i=0; i<N; i++) 
+        rtcInterpolate(scene,geomID,primIDs[i],us[i],vs[i],RTC_USER_VERTEX_BUFFER0,&result.P[7*i],&result.dPdu[7*i],&result.dPdv[7*i],7);
+      rtcInterpolateN(scene,geomID,nullptr,primIDs.data(),us.data(),vs.data(),N,RTC_USER_VERTEX_BUFFER0,result.PN.data(),nullptr,nullptr,7);
+
+      /* rtcInterpolateN returns the data in SOA layout */
+      std::vector<float> PN(result.PN);
+      for (size_t i=0; i<N; i++)
+        for (size_t j=0; j<7; j++)
+          result.PN[7*i+j] = PN[j*N+i];
+    }
+
+    static float maxError(const std::vector<float>& a, const std::vector<float>& b) 
+    {
+      float err = 0.0f;
+      for (size_t i=0; i<a.size(); i++) err = max(err,abs(a[i]-b[i]));
+      return err;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      const RTCAlgorithmFlags iflags = (RTCAlgorithmFlags) (aflags | RTC_INTERPOLATE);
+      
+      /* evaluation with and without the patch table has to give the same results */
+      Result results[2];
+      for (size_t i=0; i<2; i++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",subdiv_patch_table="+(i == 0 ? "1" : "0");
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(rtcDeviceGetError(device));
+
+        VerifyScene scene(device,sflags,iflags);
+        Ref<SceneGraph::SubdivMeshNode> mesh = SceneGraph::createSubdivSphere(zero,1.0f,8,16.0f).dynamicCast<SceneGraph::SubdivMeshNode>();
+        unsigned geomID = scene.addGeometry(RTC_GEOMETRY_STATIC,mesh.dynamicCast<SceneGraph::Node>());
+        std::vector<float> user(8*mesh->numPositions());
+        for (size_t j=0; j<user.size(); j++) user[j] = sin(float(j));
+        rtcSetBuffer(scene,geomID,RTC_USER_VERTEX_BUFFER0,user.data(),0,8*sizeof(float));
+        rtcCommit(scene);
+        AssertNoError(device);
+        evaluate(scene,geomID,mesh->verticesPerFace.size(),results[i]);
+        AssertNoError(device);
+      }
+
+      for (size_t j=0; j<64; j++)
+        if (results[0].tfar[j] < 0.0f || abs(results[0].tfar[j]-results[1].tfar[j]) > 1E-4f) return VerifyApplication::FAILED;
+      if (maxError(results[0].P,results[1].P) > 1E-4f) return VerifyApplication::FAILED;
+      if (maxError(results[0].dPdu,results[1].dPdu) > 1E-3f) return VerifyApplication::FAILED;
+      if (maxError(results[0].dPdv,results[1].dPdv) > 1E-3f) return VerifyApplication::FAILED;
+      if (maxError(results[0].PN,results[1].PN) > 1E-4f) return VerifyApplication::FAILED;
+      if (maxError(results[0].P,results[0].PN) > 1E-4f) return VerifyApplication::FAILED;
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct InstanceDoublePrecisionTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags;
+
+    InstanceDoublePrecisionTest (std::string name, int isa, RTCSceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* unit square in the xz plane centered at the origin */
+      VerifyScene object(device,RTC_SCENE_STATIC,to_aflags(imode));
+      object.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTrianglePlane(Vec3fa(-0.5f,0.0f,-0.5f),Vec3fa(1.0f,0.0f,0.0f),Vec3fa(0.0f,0.0f,1.0f),1,1));
+      rtcCommit(object);
+      AssertNoError(device);
+
+      /* instance the square rotated and far away from the origin */
+      const double c = cos(0.5), s = sin(0.5);
+      const Vec3d T(3000000.0,0.0,-2000000.0);
+      const double xfm[12] = { c,0,-s, 0,1,0, s,0,c, T.x,T.y,T.z };
+      VerifyScene scene(device,sflags,to_aflags(imode));
+      unsigned instID = rtcNewInstance2(scene,object,1);
+      rtcSetTransformd(scene,instID,RTC_MATRIX_COLUMN_MAJOR,xfm);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      /* shoot rays downwards towards the square and its surrounding */
+      const size_t numRays = 256;
+      RTCRay rays[numRays];
+      bool hit[numRays], skip[numRays];
+      for (size_t i=0; i<numRays; i++) 
+      {
+        const double lx = 1.6*(double(i%16)/15.0-0.5);
+        const double lz = 1.6*(double(i/16)/15.0-0.5);
+        const Vec3fa org(float(T.x+c*lx+s*lz),5.0f,float(T.z-s*lx+c*lz));
+
+        /* rays origins are rounded to float, thus calculate the exact local hit location */
+        const double dx = double(org.x)-T.x, dz = double(org.z)-T.z;
+        const double hx = c*dx-s*dz, hz = s*dx+c*dz;
+        hit[i]  = abs(hx) < 0.5 && abs(hz) < 0.5;
+        skip[i] = abs(abs(hx)-0.5) < 0.01 || abs(abs(hz)-0.5) < 0.01;
+        rays[i] = makeRay(org,Vec3fa(0.0f,-1.0f,0.0f));
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,numRays);
+
+      for (size_t i=0; i<numRays; i++) 
+      {
+        if (skip[i]) continue;
+        if (hit[i] != (rays[i].geomID != RTC_INVALID_GEOMETRY_ID)) return VerifyApplication::FAILED;
+        if (hit[i] && (ivariant & VARIANT_INTERSECT)) {
+          if (rays[i].instID != instID || abs(rays[i].tfar-5.0f) > 1E-4f) 
+            return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TriangleMeshletTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags;
+    RTCGeometryFlags gflags;
+
+    TriangleMeshletTest (std::string name, int isa, RTCSceneFlags sflags, RTCGeometryFlags gflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gflags(gflags) {}
+
+    /* creates a triangle soup without any shared vertices */
+    static unsigned addTriangleSoup(RTCScene scene, RTCGeometryFlags gflags, const avector<Vec3fa>& soup)
+    {
+      const size_t numTriangles = soup.size()/3;
+      unsigned geomID = rtcNewTriangleMesh(scene,gflags,numTriangles,3*numTriangles);
+      Vec3fa* vertices = (Vec3fa*) rtcMapBuffer(scene,geomID,RTC_VERTEX_BUFFER);
+      Triangle* triangles = (Triangle*) rtcMapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+      for (size_t i=0; i<numTriangles; i++) {
+        for (size_t j=0; j<3; j++) vertices[3*i+j] = soup[3*i+j];
+        triangles[i] = Triangle(int(3*i+0),int(3*i+1),int(3*i+2));
+      }
+      rtcUnmapBuffer(scene,geomID,RTC_VERTEX_BUFFER);
+      rtcUnmapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+      return geomID;
+    }
+
+    /* moves all vertices of some triangle mesh */
+    static void moveTriangleMesh(RTCScene scene, unsigned geomID, size_t numVertices, const Vec3fa& dpos)
+    {
+      Vec3fa* vertices = (Vec3fa*) rtcMapBuffer(scene,geomID,RTC_VERTEX_BUFFER);
+      for (size_t i=0; i<numVertices; i++) vertices[i] += dpos;
+      rtcUnmapBuffer(scene,geomID,RTC_VERTEX_BUFFER);
+      rtcUpdate(scene,geomID);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      if (!supportsIntersectMode(device0,imode))
+        return VerifyApplication::SKIPPED;
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",tri_accel=bvh4.triangle4m").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+
+      /* build the same scene with the default and the meshlet acceleration structure */
+      avector<Vec3fa> soup;
+      for (size_t i=0; i<200; i++) {
+        const Vec3fa p = Vec3fa(0.0f,0.0f,2.0f) + 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+        for (size_t j=0; j<3; j++) soup.push_back(p + 0.2f*random_Vec3fa());
+      }
+      VerifyScene scene0(device0,sflags,to_aflags(imode));
+      VerifyScene scene1(device1,sflags,to_aflags(imode));
+      RTCScene scenes[2] = { scene0, scene1 };
+      for (size_t k=0; k<2; k++)
+      {
+        VerifyScene& scene = k == 0 ? scene0 : scene1;
+        scene.addSphere(sampler,gflags,Vec3fa(-1.5f,0.0f,0.0f),1.0f,50);
+        scene.addGeometry(gflags,SceneGraph::createTrianglePlane(Vec3fa(1.0f,-1.0f,-1.0f),Vec3fa(2.0f,0.0f,0.0f),Vec3fa(0.0f,2.0f,0.0f),20,20));
+        addTriangleSoup(scene,gflags,soup);
+        rtcCommit(scene);
+        AssertNoError(scene.device);
+      }
+
+      for (size_t iter=0; iter<2; iter++)
+      {
+        /* deformable and dynamic planes get moved to test refitting and rebuilding of the meshlets */
+        if (iter == 1) {
+          if (gflags == RTC_GEOMETRY_STATIC) break;
+          for (size_t k=0; k<2; k++) {
+            moveTriangleMesh(scenes[k],1,21*21,Vec3fa(0.0f,0.5f,0.0f));
+            rtcCommit(scenes[k]);
+          }
+        }
+
+        const size_t numRays = 256;
+        RTCRay rays0[numRays], rays1[numRays];
+        for (size_t i=0; i<numRays; i++) {
+          const Vec3fa org = 6.0f*random_Vec3fa() - Vec3fa(3.0f);
+          const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+          rays0[i] = rays1[i] = makeRay(org,dir);
+        }
+        IntersectWithMode(imode,ivariant,scene0,rays0,numRays);
+        IntersectWithMode(imode,ivariant,scene1,rays1,numRays);
+
+        for (size_t i=0; i<numRays; i++)
+        {
+          if (rays0[i].geomID != rays1[i].geomID) return VerifyApplication::FAILED;
+          if (rays0[i].geomID == RTC_INVALID_GEOMETRY_ID || !(ivariant & VARIANT_INTERSECT)) continue;
+          if (rays0[i].primID != rays1[i].primID) return VerifyApplication::FAILED;
+          if (abs(rays0[i].tfar-rays1[i].tfar) > 1E-5f*max(1.0f,rays0[i].tfar)) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct VertexWeldingTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags;
+
+    VertexWeldingTest (std::string name, int isa, RTCSceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* creates a mesh with owned buffers where each primitive stores its own copy of its vertices */
+    static unsigned addUnweldedMesh(RTCScene scene, Ref<SceneGraph::Node> node, const Vec3fa& motion)
+    {
+      std::vector<unsigned> indices; avector<Vec3fa> positions;
+      unsigned geomID = RTC_INVALID_GEOMETRY_ID;
+      if (Ref<SceneGraph::TriangleMeshNode> mesh = node.dynamicCast<SceneGraph::TriangleMeshNode>())
+      {
+        for (const auto& tri : mesh->triangles) {
+          positions.push_back(mesh->positions[0][tri.v0]);
+          positions.push_back(mesh->positions[0][tri.v1]);
+          positions.push_back(mesh->positions[0][tri.v2]);
+        }
+        geomID = rtcNewTriangleMesh(scene,RTC_GEOMETRY_STATIC,positions.size()/3,positions.size(),2);
+      }
+      else if (Ref<SceneGraph::QuadMeshNode> mesh = node.dynamicCast<SceneGraph::QuadMeshNode>())
+      {
+        for (const auto& quad : mesh->quads) {
+          positions.push_back(mesh->positions[0][quad.v0]);
+          positions.push_back(mesh->positions[0][quad.v1]);
+          positions.push_back(mesh->positions[0][quad.v2]);
+          positions.push_back(mesh->positions[0][quad.v3]);
+        }
+        geomID = rtcNewQuadMesh(scene,RTC_GEOMETRY_STATIC,positions.size()/4,positions.size(),2);
+      }
+
+      unsigned* index = (unsigned*) rtcMapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+      Vec3fa* vertices0 = (Vec3fa*) rtcMapBuffer(scene,geomID,RTC_VERTEX_BUFFER0);
+      Vec3fa* vertices1 = (Vec3fa*) rtcMapBuffer(scene,geomID,RTC_VERTEX_BUFFER1);
+      for (size_t i=0; i<positions.size(); i++) {
+        index[i] = unsigned(i);
+        vertices0[i] = positions[i];
+        vertices1[i] = positions[i] + motion;
+      }
+      rtcUnmapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+      rtcUnmapBuffer(scene,geomID,RTC_VERTEX_BUFFER0);
+      rtcUnmapBuffer(scene,geomID,RTC_VERTEX_BUFFER1);
+      return geomID;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      if (!supportsIntersectMode(device0,imode))
+        return VerifyApplication::SKIPPED;
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",vertex_welding=1").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+
+      /* build the same scene with and without vertex welding */
+      const RTCAlgorithmFlags aflags = RTCAlgorithmFlags(to_aflags(imode) | RTC_INTERPOLATE);
+      VerifyScene scene0(device0,sflags,aflags);
+      VerifyScene scene1(device1,sflags,aflags);
+      for (size_t k=0; k<2; k++)
+      {
+        VerifyScene& scene = k == 0 ? scene0 : scene1;
+        addUnweldedMesh(scene,SceneGraph::createTrianglePlane(Vec3fa(-2.0f,-1.0f,-1.0f),Vec3fa(2.0f,0.0f,0.0f),Vec3fa(0.0f,2.0f,0.0f),20,20),Vec3fa(0.0f));
+        addUnweldedMesh(scene,SceneGraph::createQuadPlane(Vec3fa(0.0f,-1.0f,-1.0f),Vec3fa(2.0f,0.0f,0.0f),Vec3fa(0.0f,2.0f,0.0f),20,20),Vec3fa(0.0f,0.0f,0.1f));
+        rtcCommit(scene);
+        AssertNoError(scene.device);
+      }
+
+      const size_t numRays = 256;
+      RTCRay rays0[numRays], rays1[numRays];
+      for (size_t i=0; i<numRays; i++) {
+        const Vec3fa org = Vec3fa(4.0f*random_float()-2.0f,2.0f*random_float()-1.0f,-2.0f);
+        const Vec3fa dir = Vec3fa(0.2f*random_float()-0.1f,0.2f*random_float()-0.1f,1.0f);
+        rays0[i] = rays1[i] = makeRay(org,dir);
+      }
+      IntersectWithMode(imode,ivariant,scene0,rays0,numRays);
+      IntersectWithMode(imode,ivariant,scene1,rays1,numRays);
+
+      for (size_t i=0; i<numRays; i++)
+      {
+        if (rays0[i].geomID != rays1[i].geomID) return VerifyApplication::FAILED;
+        if (rays0[i].geomID == RTC_INVALID_GEOMETRY_ID || !(ivariant & VARIANT_INTERSECT)) continue;
+        if (rays0[i].primID != rays1[i].primID) return VerifyApplication::FAILED;
+        if (abs(rays0[i].tfar-rays1[i].tfar) > 1E-5f*max(1.0f,rays0[i].tfar)) return VerifyApplication::FAILED;
+
+        /* interpolation has to use the remapped indices and compacted vertices */
+        Vec3fa P0(0.0f), P1(0.0f);
+        rtcInterpolate(scene0,rays0[i].geomID,rays0[i].primID,rays0[i].u,rays0[i].v,RTC_VERTEX_BUFFER0,&P0.x,nullptr,nullptr,3);
+        rtcInterpolate(scene1,rays1[i].geomID,rays1[i].primID,rays1[i].u,rays1[i].v,RTC_VERTEX_BUFFER0,&P1.x,nullptr,nullptr,3);
+        if (reduce_max(abs(P0-P1)) > 1E-5f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  /* adds long thin diagonal primitives, that have large bounding boxes compared to their surface area */
+  static unsigned addLongThinGeometry(RTCScene scene, GeometryType gtype, size_t numPrimitives, int seed)
+  {
+    RandomSampler sampler;
+    RandomSampler_init(sampler,seed);
+    const bool mblur = gtype == TRIANGLE_MESH_MB || gtype == QUAD_MESH_MB || gtype == LINE_GEOMETRY_MB;
+    const size_t numTimeSteps = mblur ? 3 : 1;
+
+    unsigned geomID = RTC_INVALID_GEOMETRY_ID;
+    size_t numVertices = 0;
+    switch (gtype) {
+    case TRIANGLE_MESH: case TRIANGLE_MESH_MB: numVertices = 3; geomID = rtcNewTriangleMesh(scene,RTC_GEOMETRY_STATIC,numPrimitives,3*numPrimitives,numTimeSteps); break;
+    case QUAD_MESH    : case QUAD_MESH_MB    : numVertices = 4; geomID = rtcNewQuadMesh    (scene,RTC_GEOMETRY_STATIC,numPrimitives,4*numPrimitives,numTimeSteps); break;
+    case LINE_GEOMETRY: case LINE_GEOMETRY_MB: numVertices = 2; geomID = rtcNewLineSegments(scene,RTC_GEOMETRY_STATIC,numPrimitives,2*numPrimitives,numTimeSteps); break;
+    default: throw std::runtime_error("invalid geometry for long thin primitives");
+    }
+
+    unsigned* indices = (unsigned*) rtcMapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+    if (numVertices == 2) for (size_t i=0; i<numPrimitives; i++) indices[i] = unsigned(2*i);
+    else for (size_t i=0; i<numVertices*numPrimitives; i++) indices[i] = unsigned(i);
+    rtcUnmapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+
+    std::vector<Vec3fa*> vertices(numTimeSteps);
+    for (size_t t=0; t<numTimeSteps; t++)
+      vertices[t] = (Vec3fa*) rtcMapBuffer(scene,geomID,RTCBufferType(RTC_VERTEX_BUFFER0+t));
+
+    for (size_t i=0; i<numPrimitives; i++)
+    {
+      const Vec3fa P = 2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f);
+      const Vec3fa L = 0.5f*normalize(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+      const Vec3fa W = 0.002f*normalize(cross(L,2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f)));
+      const Vec3fa M = 0.05f*(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+      const Vec3fa v[4] = { P-L, P+L, P+L+W, P-L+W };
+      for (size_t t=0; t<numTimeSteps; t++) 
+      {
+        for (size_t j=0; j<numVertices; j++) {
+          vertices[t][numVertices*i+j] = v[j] + float(t)*M;
+          if (numVertices == 2) vertices[t][numVertices*i+j].w = 0.002f;
+        }
+      }
+    }
 
-      for (size_t i=0; i<256; i++)
-      {
-        if (rays[i].geomID != 0) return VerifyApplication::FAILED;
-        if (ivariant & VARIANT_OCCLUDED) continue;
-        if (rays[i].primID != 0) return VerifyApplication::FAILED;
-        if (abs(rays[i].u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+    for (size_t t=0; t<numTimeSteps; t++)
+      rtcUnmapBuffer(scene,geomID,RTCBufferType(RTC_VERTEX_BUFFER0+t));
+    return geomID;
+  }
 
-        const Vec3fa org(rays[i].org[0],rays[i].org[1],rays[i].org[2]);
-        const Vec3fa dir(rays[i].dir[0],rays[i].dir[1],rays[i].dir[2]);
-        const Vec3fa ht  = org + rays[i].tfar*dir;
-        const Vec3fa huv = vertices[0] + rays[i].u*(vertices[1]-vertices[0]) + rays[i].v*(vertices[3]-vertices[0]);
-        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2])); // FIXME: some geom normals are scaled!!!??
-        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,-1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+  struct PresplitTest : public VerifyApplication::Test
+  {
+    GeometryType gtype;
+    RTCSceneFlags sflags;
+
+    PresplitTest (std::string name, int isa, GeometryType gtype, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), gtype(gtype), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",tri_builder_mb=sah_presplit,quad_builder=sah_presplit,quad_builder_mb=sah_presplit,"
+                                           "line_builder=sah_presplit,line_builder_mb=sah_presplit,max_spatial_split_replications=4").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+
+      /* build the same scene with and without presplitting */
+      RTCSceneRef scene0 = rtcDeviceNewScene(device0,sflags,RTC_INTERSECT1);
+      RTCSceneRef scene1 = rtcDeviceNewScene(device1,sflags,RTC_INTERSECT1);
+      addLongThinGeometry(scene0,gtype,1000,int(gtype));
+      addLongThinGeometry(scene1,gtype,1000,int(gtype));
+      rtcCommit(scene0);
+      AssertNoError(device0);
+      rtcCommit(scene1);
+      AssertNoError(device1);
+
+      /* split primitive references have to report the same hits */
+      RandomSampler sampler;
+      RandomSampler_init(sampler,int(gtype));
+      for (size_t i=0; i<4096; i++)
+      {
+        const Vec3fa org = 3.0f*(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+        const Vec3fa dir = -org + 0.5f*(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+        RTCRay ray0 = makeRay(org,dir); ray0.time = RandomSampler_get1D(sampler);
+        RTCRay ray1 = ray0;
+        rtcIntersect(scene0,ray0);
+        rtcIntersect(scene1,ray1);
+        if (ray0.geomID != ray1.geomID) return VerifyApplication::FAILED;
+        if (ray0.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (abs(ray0.tfar-ray1.tfar) > 1E-4f*max(1.0f,ray0.tfar)) return VerifyApplication::FAILED;
+
+        RTCRay shadow = makeRay(org,dir,0.0f,1.001f*ray0.tfar); shadow.time = ray0.time;
+        rtcOccluded(scene1,shadow);
+        if (shadow.geomID != 0) return VerifyApplication::FAILED;
       }
-      AssertNoError(device);
-      
+      AssertNoError(device0);
+      AssertNoError(device1);
       return VerifyApplication::PASSED;
     }
   };
-  
+
   struct RayMasksTest : public VerifyApplication::IntersectTest
   {
     RTCSceneFlags sflags; 
@@ -2232,6 +3166,91 @@ namespace embree
     }
   };
 
+  struct CompactStreamTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+    RTCIntersectFlags iflags;
+
+    static const size_t N = 10;
+    static const size_t maxStreamSize = 100;
+    
+    CompactStreamTest (std::string name, int isa, RTCSceneFlags sflags, RTCIntersectFlags iflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), iflags(iflags) {}
+   
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,MODE_INTERSECTNp))
+        return VerifyApplication::SKIPPED;
+
+      Vec3fa pos = zero;
+      VerifyScene scene(device,sflags,aflags_all);
+      scene.addSphere(sampler,RTC_GEOMETRY_STATIC,pos,2.0f,50);
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      RTCIntersectContext context;
+      context.flags = iflags;
+      context.userRayExt = nullptr;
+
+      size_t numFailures = 0;
+      for (size_t i=0; i<size_t(N*state->intensity); i++) 
+      {
+        for (size_t M=1; M<maxStreamSize; M++)
+        {
+          __aligned(16) RTCRay rays[maxStreamSize];
+          float orgx[maxStreamSize], orgy[maxStreamSize], orgz[maxStreamSize];
+          float dirx[maxStreamSize], diry[maxStreamSize], dirz[maxStreamSize];
+          float tnear[maxStreamSize], tfar[maxStreamSize];
+          for (size_t j=0; j<M; j++) 
+          {
+            Vec3fa org = pos+4.0f*random_Vec3fa()-Vec3fa(2.0f);
+            Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+            rays[j] = makeRay(org,dir,0.0f,(rand()%4) ? random_float() : float(pos_inf)); 
+            if (rand()%8 == 0) { rays[j].tnear = pos_inf; rays[j].tfar = neg_inf; } // some inactive rays
+            orgx[j] = rays[j].org[0]; orgy[j] = rays[j].org[1]; orgz[j] = rays[j].org[2];
+            dirx[j] = rays[j].dir[0]; diry[j] = rays[j].dir[1]; dirz[j] = rays[j].dir[2];
+            tnear[j] = rays[j].tnear; tfar[j] = rays[j].tfar;
+          }
+
+          /* only the ray data pointers are set, the hit data pointers are invalid */
+          RTCRayNp rayp;
+          memset(&rayp,-1,sizeof(RTCRayNp));
+          rayp.orgx = orgx; rayp.orgy = orgy; rayp.orgz = orgz;
+          rayp.dirx = dirx; rayp.diry = diry; rayp.dirz = dirz;
+          rayp.tnear = tnear; rayp.tfar = tfar;
+          rayp.time = nullptr; rayp.mask = nullptr;
+
+          unsigned occluded[(maxStreamSize+31)/32];
+          memset(occluded,-1,sizeof(occluded));
+          rtcOccludedNpMask(scene,&context,rayp,occluded,M);
+
+          RTCCompactHit hits[maxStreamSize];
+          rtcIntersectNpCompact(scene,&context,rayp,hits,M);
+          AssertNoError(device);
+
+          for (size_t j=0; j<M; j++) 
+          {
+            if (tfar[j] != rays[j].tfar) numFailures++; // ray data must not get modified
+            const bool active = rays[j].tnear <= rays[j].tfar;
+            RTCRay ray0 = rays[j]; if (active) rtcOccluded (scene,ray0);
+            RTCRay ray1 = rays[j]; if (active) rtcIntersect(scene,ray1);
+            const bool isOccluded = (occluded[j/32] >> (j%32)) & 1;
+            numFailures += isOccluded != (active && ray0.geomID == 0);
+            numFailures += hits[j].geomID != ray1.geomID;
+            if (ray1.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+            numFailures += hits[j].primID != ray1.primID;
+            numFailures += abs(hits[j].t - ray1.tfar) > 16.0f*float(ulp)*max(1.0f,ray1.tfar);
+          }
+        }
+      }
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
   struct WatertightTest : public VerifyApplication::IntersectTest
   {
     ALIGNED_STRUCT;
@@ -2241,12 +3260,14 @@ namespace embree
     static const size_t N = 10;
     static const size_t maxStreamSize = 100;
     
-    WatertightTest (std::string name, int isa, RTCSceneFlags sflags, IntersectMode imode, std::string model, const Vec3fa& pos)
-      : VerifyApplication::IntersectTest(name,isa,imode,VARIANT_INTERSECT,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), model(model), pos(pos) {}
+    std::string rtcore;
+    
+    WatertightTest (std::string name, int isa, RTCSceneFlags sflags, IntersectMode imode, std::string model, const Vec3fa& pos, std::string rtcore = "")
+      : VerifyApplication::IntersectTest(name,isa,imode,VARIANT_INTERSECT,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), model(model), pos(pos), rtcore(rtcore) {}
     
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
-      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+rtcore;
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(rtcDeviceGetError(device));
       if (!supportsIntersectMode(device,imode))
@@ -3073,6 +4094,139 @@ namespace embree
     return true;
   }
 
+  struct JobSystemTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    JobSystemTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* minimal job system that executes jobs on a bounded number of additional threads */
+    struct JobSystem
+    {
+      static const size_t maxThreads = 4;
+
+      JobSystem () : numCalls(0), numActiveThreads(0) {}
+
+      static void runJobs(void* userPtr, RTCJobFunc job, void* jobPtr, size_t jobCount)
+      {
+        JobSystem* This = (JobSystem*) userPtr;
+        This->numCalls++;
+        std::vector<std::thread> threads;
+        for (size_t i=0; i<jobCount; i++)
+        {
+          if (i+1 < jobCount && This->numActiveThreads.fetch_add(1) < maxThreads) {
+            threads.push_back(std::thread([=] () { job(jobPtr,i,jobCount); This->numActiveThreads--; }));
+            continue;
+          }
+          if (i+1 < jobCount) This->numActiveThreads--;
+          job(jobPtr,i,jobCount);
+        }
+        for (auto& thread : threads) thread.join();
+      }
+
+      static size_t threadIndex(void* userPtr) {
+        return std::hash<std::thread::id>()(std::this_thread::get_id()) % (maxThreads+1);
+      }
+
+      std::atomic<size_t> numCalls;
+      std::atomic<size_t> numActiveThreads;
+    };
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      if (rtcDeviceGetParameter1i(device,RTC_CONFIG_TASKING_SYSTEM) != 2)
+        return VerifyApplication::SKIPPED;
+
+      JobSystem jobSystem;
+      rtcDeviceSetJobSystem(device,JobSystem::runJobs,JobSystem::threadIndex,JobSystem::maxThreads+1,&jobSystem);
+      AssertNoError(device);
+
+      VerifyScene scene(device,sflags,RTC_INTERSECT1);
+      for (size_t i=0; i<16; i++) {
+        const Vec3fa pos = Vec3fa(4.0f*float(i%4),4.0f*float(i/4),0.0f);
+        scene.addSphere(sampler,RTC_GEOMETRY_STATIC,pos,1.0f,50);
+        scene.addQuadSphere(sampler,RTC_GEOMETRY_STATIC,pos+Vec3fa(0.0f,0.0f,4.0f),1.0f,50);
+      }
+      rtcCommit(scene);
+      AssertNoError(device);
+      rtcDeviceSetJobSystem(device,nullptr,nullptr,0,nullptr);
+      AssertNoError(device);
+
+      /* the build has to run through the job system and produce a valid hierarchy */
+      if (jobSystem.numCalls == 0) return VerifyApplication::FAILED;
+      for (size_t i=0; i<16; i++)
+      {
+        const Vec3fa pos = Vec3fa(4.0f*float(i%4),4.0f*float(i/4),0.0f);
+        RTCRay ray = makeRay(pos-Vec3fa(0.0f,0.0f,4.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rtcIntersect(scene,ray);
+        if (ray.geomID != 2*i || abs(ray.tfar-3.0f) > 1E-2f) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct IsolatedThreadsTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    IsolatedThreadsTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static bool buildAndTrace(const RTCDeviceRef& device, RTCSceneFlags sflags, float offset)
+    {
+      RandomSampler sampler;
+      RandomSampler_init(sampler,int(offset));
+      VerifyScene scene(device,sflags,RTC_INTERSECT1);
+      for (size_t i=0; i<16; i++) {
+        const Vec3fa pos = Vec3fa(4.0f*float(i%4),4.0f*float(i/4),offset);
+        scene.addSphere(sampler,RTC_GEOMETRY_STATIC,pos,1.0f,50);
+      }
+      rtcCommit(scene);
+      if (rtcDeviceGetError(device) != RTC_NO_ERROR) return false;
+
+      for (size_t i=0; i<16; i++)
+      {
+        const Vec3fa pos = Vec3fa(4.0f*float(i%4),4.0f*float(i/4),offset);
+        RTCRay ray = makeRay(pos-Vec3fa(0.0f,0.0f,4.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rtcIntersect(scene,ray);
+        if (ray.geomID != i || abs(ray.tfar-3.0f) > 1E-2f) return false;
+      }
+      return true;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice((cfg+",threads=4,isolated_threads=1,set_affinity=0").c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",threads=2,isolated_threads=1,set_affinity=0").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+      RTCDeviceRef device2 = rtcNewDevice((cfg+",set_affinity=0").c_str());
+      errorHandler(rtcDeviceGetError(device2));
+
+      /* concurrent commits on devices with private and shared thread pools */
+      std::atomic<size_t> numFailed(0);
+      std::vector<std::thread> threads;
+      const RTCDeviceRef* devices[3] = { &device0, &device1, &device2 };
+      for (size_t i=0; i<3; i++) {
+        threads.push_back(std::thread([&,i] () {
+              for (size_t j=0; j<4; j++)
+                if (!buildAndTrace(*devices[i],sflags,float(i))) numFailed++;
+            }));
+      }
+      for (auto& thread : threads) thread.join();
+
+      AssertNoError(device0);
+      AssertNoError(device1);
+      AssertNoError(device2);
+      return numFailed == 0 ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   struct MemoryMonitorTest : public VerifyApplication::Test
   {
     thread_func func;
@@ -3515,6 +4669,60 @@ namespace embree
 
   static std::atomic<ssize_t> bytes_used(0);
 
+  struct LongThinRaysBenchmark : public ParallelIntersectBenchmark
+  {
+    GeometryType gtype;
+    std::string builder;
+    RTCDeviceRef device;
+    Ref<VerifyScene> scene;
+    static const size_t numPrimitives = 1000;
+    static const size_t numRays = 1024*1024;
+    static const size_t deltaRays = 1024;
+
+    LongThinRaysBenchmark (std::string name, int isa, GeometryType gtype, std::string builder)
+      : ParallelIntersectBenchmark(name,isa,numRays,deltaRays), gtype(gtype), builder(builder), device(nullptr) {}
+
+    bool setup(VerifyApplication* state) 
+    {
+      if (!ParallelIntersectBenchmark::setup(state))
+        return false;
+
+      std::string cfg = state->rtcore + ",start_threads=1,set_affinity=1,isa="+stringOfISA(isa);
+      cfg += ",tri_builder_mb="+builder+",quad_builder="+builder+",quad_builder_mb="+builder+",line_builder="+builder+",line_builder_mb="+builder;
+      device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      rtcDeviceSetErrorFunction(device,errorHandler);
+
+      scene = new VerifyScene(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+      addLongThinGeometry(*scene,gtype,numPrimitives,int(gtype));
+      rtcCommit (*scene);
+      AssertNoError(device);
+      return true;
+    }
+
+    void render_block(size_t i, size_t dn)
+    {
+      RandomSampler sampler;
+      RandomSampler_init(sampler, (int)i);
+
+      for (size_t j=0; j<dn; j++) 
+      {
+        const Vec3fa org = 3.0f*(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+        const Vec3fa dir = -org + 0.5f*(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+        RTCRay ray = fastMakeRay(org,dir); ray.time = RandomSampler_get1D(sampler);
+        rtcIntersect(*scene,ray);
+      }
+    }
+
+    virtual void cleanup(VerifyApplication* state) 
+    {
+      AssertNoError(device);
+      scene = nullptr;
+      device = nullptr;
+      ParallelIntersectBenchmark::cleanup(state);
+    }
+  };
+
   struct CreateGeometryBenchmark : public VerifyApplication::Benchmark
   {
     GeometryType gtype;
@@ -3861,6 +5069,16 @@ namespace embree
         groups.top()->add(new InterpolateHairTest(std::to_string((long long)(s)),isa,s));
       groups.pop();
 
+      push(new TestGroup("triangles_N",true,true));
+      for (auto s : interpolateTests) 
+        groups.top()->add(new InterpolateNTest(std::to_string((long long)(s)),isa,s,false));
+      groups.pop();
+
+      push(new TestGroup("quads_N",true,true));
+      for (auto s : interpolateTests) 
+        groups.top()->add(new InterpolateNTest(std::to_string((long long)(s)),isa,s,true));
+      groups.pop();
+
       groups.pop();
       
       /**************************************************************************/
@@ -3883,6 +5101,71 @@ namespace embree
                 groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
       groups.pop();
 
+      push(new TestGroup("tessellation_cameras",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new TessellationCamerasTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("tessellation_cache_file",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new TessellationCacheFileTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("displacement_batch",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new DisplacementBatchTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("subdiv_topology_update",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new SubdivTopologyUpdateTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("subdiv_patch_table",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new SubdivPatchTableTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("time_steps_hit",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+                groups.top()->add(new TimeStepsHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("triangle_meshlets",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto gflags : {RTC_GEOMETRY_STATIC, RTC_GEOMETRY_DEFORMABLE, RTC_GEOMETRY_DYNAMIC})
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant) && ((sflags & RTC_SCENE_DYNAMIC) || gflags == RTC_GEOMETRY_STATIC))
+                groups.top()->add(new TriangleMeshletTest(to_string(sflags,gflags)+"."+to_string(imode,ivariant),isa,sflags,gflags,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("vertex_welding",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+              groups.top()->add(new VertexWeldingTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("presplit",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto gtype : {TRIANGLE_MESH_MB, QUAD_MESH, QUAD_MESH_MB, LINE_GEOMETRY, LINE_GEOMETRY_MB})
+          if (!(sflags & RTC_SCENE_DYNAMIC))
+            groups.top()->add(new PresplitTest(to_string(sflags)+"."+to_string(gtype),isa,gtype,sflags));
+      groups.pop();
+
+      push(new TestGroup("instance_double_precision",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+              groups.top()->add(new InstanceDoublePrecisionTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
+
       if (rtcDeviceGetParameter1i(device,RTC_CONFIG_RAY_MASK)) 
       {
         push(new TestGroup("ray_masks",true,true));
@@ -3932,6 +5215,14 @@ namespace embree
                   groups.top()->add(new InactiveRaysTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
       groups.pop();
       
+      push(new TestGroup("compact_stream",true,true));
+      for (auto sflags : sceneFlags) 
+      {
+        groups.top()->add(new CompactStreamTest(to_string(sflags)+".coherent"  ,isa,sflags,RTC_INTERSECT_COHERENT));
+        groups.top()->add(new CompactStreamTest(to_string(sflags)+".incoherent",isa,sflags,RTC_INTERSECT_INCOHERENT));
+      }
+      groups.pop();
+      
       push(new TestGroup("watertight_triangles",true,true)); {
         std::string watertightModels [] = {"sphere.triangles", "plane.triangles"};
         const Vec3fa watertight_pos = Vec3fa(148376.0f,1234.0f,-223423.0f);
@@ -3942,6 +5233,16 @@ namespace embree
         groups.pop();
       }
 
+      push(new TestGroup("watertight_triangles_meshlets",true,true)); {
+        std::string watertightModels [] = {"sphere.triangles", "plane.triangles"};
+        const Vec3fa watertight_pos = Vec3fa(148376.0f,1234.0f,-223423.0f);
+        for (auto sflags : sceneFlagsRobust) 
+          for (auto imode : intersectModes) 
+            for (std::string model : watertightModels) 
+              groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,watertight_pos,",tri_accel=bvh4.triangle4m"));
+        groups.pop();
+      }
+
       push(new TestGroup("watertight_triangles_mb",true,true)); {
         std::string watertightModels [] = {"sphere.triangles_mb", "plane.triangles_mb"};
         const Vec3fa watertight_pos = Vec3fa(148376.0f,1234.0f,-223423.0f);
@@ -4035,6 +5336,16 @@ namespace embree
       groups.top()->add(new MemoryMonitorTest("regression_static_memory_monitor", isa,rtcore_regression_static_thread,30));
       groups.top()->add(new MemoryMonitorTest("regression_dynamic_memory_monitor",isa,rtcore_regression_dynamic_thread,300));
 
+      push(new TestGroup("external_job_system",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new JobSystemTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("isolated_threads",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new IsolatedThreadsTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
       /**************************************************************************/
       /*                           Benchmarks                                   */
       /**************************************************************************/
@@ -4084,6 +5395,10 @@ namespace embree
             groups.top()->add(new IncoherentRaysBenchmark("incoherent."+to_string(gtype)+"_1000k."+to_string(sflags.first,imode.first,imode.second),
                                                           isa,gtype,sflags.first,sflags.second,imode.first,imode.second,501));
 
+      for (auto gtype : {TRIANGLE_MESH_MB, QUAD_MESH, QUAD_MESH_MB, LINE_GEOMETRY, LINE_GEOMETRY_MB})
+        for (auto builder : {"sah", "sah_presplit"})
+          groups.top()->add(new LongThinRaysBenchmark("long_thin."+to_string(gtype)+"_1k."+builder,isa,gtype,builder));
+
       std::vector<std::pair<RTCSceneFlags,RTCGeometryFlags>> benchmark_create_sflags_gflags;
       benchmark_create_sflags_gflags.push_back(std::make_pair(RTC_SCENE_STATIC,RTC_GEOMETRY_STATIC));
       //benchmark_create_sflags_gflags.push_back(std::make_pair(RTC_SCENE_DYNAMIC,RTC_GEOMETRY_STATIC));